@@ -0,0 +1,143 @@
+// Times UniformGrid against brute force as the entity count grows from 10 to
+// 10,000: ball-sized boxes drift and bounce around the design space, and each
+// tick does the incremental grid update, one hero-sized query, and an
+// all-pairs overlap pass. Brute-force pair counts are compared with the grid's
+// to check it finds the same overlaps.
+//
+// Usage: broadphase_bench [ticks]
+
+#include <SDL2/SDL.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "game/Broadphase.h"
+
+namespace {
+constexpr SDL_FRect kBounds{-256.0f, -256.0f, 1216.0f + 512.0f, 800.0f + 512.0f};
+constexpr float kCellSize = 128.0f;
+constexpr SDL_FRect kHero{568.0f, 536.0f, 80.0f, 80.0f};
+constexpr std::uint32_t kCategory = 1u;
+
+struct Bodies {
+    std::vector<float> x;
+    std::vector<float> y;
+    std::vector<float> vel_x;
+    std::vector<float> vel_y;
+    std::vector<float> radius;
+};
+
+bool Overlaps(const SDL_FRect& a, const SDL_FRect& b) {
+    return !(a.x > b.x + b.w || a.x + a.w < b.x || a.y > b.y + b.h || a.y + a.h < b.y);
+}
+
+SDL_FRect Box(const Bodies& bodies, int i) {
+    const float r = bodies.radius[i];
+    return SDL_FRect{bodies.x[i] - r, bodies.y[i] - r, r * 2.0f, r * 2.0f};
+}
+
+void Step(Bodies* bodies, float delta_seconds) {
+    for (std::size_t i = 0; i < bodies->x.size(); ++i) {
+        bodies->x[i] += bodies->vel_x[i] * delta_seconds;
+        bodies->y[i] += bodies->vel_y[i] * delta_seconds;
+        if (bodies->x[i] < 0.0f || bodies->x[i] > 1216.0f) {
+            bodies->vel_x[i] = -bodies->vel_x[i];
+        }
+        if (bodies->y[i] < 0.0f || bodies->y[i] > 800.0f) {
+            bodies->vel_y[i] = -bodies->vel_y[i];
+        }
+    }
+}
+
+double Micros(std::chrono::steady_clock::duration duration) {
+    return std::chrono::duration<double, std::micro>(duration).count();
+}
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    const int ticks = (argc > 1) ? std::max(1, std::atoi(argv[1])) : 120;
+    const float step = 1.0f / 120.0f;
+    using Clock = std::chrono::steady_clock;
+
+    std::printf("ticks: %d  cell: %.0f  (times are us per tick)\n", ticks, kCellSize);
+    std::printf("%8s %10s %12s %12s %14s %14s %10s %6s\n", "entities", "grid upd", "hero brute", "hero grid",
+                "pairs brute", "pairs grid", "pairs", "same");
+    const int counts[] = {10, 100, 1000, 10000};
+    for (int count : counts) {
+        std::mt19937 rng(42u);
+        std::uniform_real_distribution<float> pos_x(0.0f, 1216.0f);
+        std::uniform_real_distribution<float> pos_y(0.0f, 800.0f);
+        std::uniform_real_distribution<float> speed(-200.0f, 200.0f);
+        std::uniform_real_distribution<float> radius(8.0f, 60.0f);
+        Bodies bodies;
+        for (int i = 0; i < count; ++i) {
+            bodies.x.push_back(pos_x(rng));
+            bodies.y.push_back(pos_y(rng));
+            bodies.vel_x.push_back(speed(rng));
+            bodies.vel_y.push_back(speed(rng));
+            bodies.radius.push_back(radius(rng));
+        }
+
+        UniformGrid grid(kBounds, kCellSize, count);
+        std::vector<std::pair<int, int>> pairs;
+        Clock::duration update_time{};
+        Clock::duration hero_brute_time{};
+        Clock::duration hero_grid_time{};
+        Clock::duration pairs_brute_time{};
+        Clock::duration pairs_grid_time{};
+        long long pair_total = 0;
+        bool same = true;
+
+        for (int tick = 0; tick < ticks; ++tick) {
+            Step(&bodies, step);
+
+            Clock::time_point start = Clock::now();
+            for (int i = 0; i < count; ++i) {
+                grid.Update(i, Box(bodies, i), kCategory);
+            }
+            update_time += Clock::now() - start;
+
+            start = Clock::now();
+            int brute_hits = 0;
+            for (int i = 0; i < count; ++i) {
+                brute_hits += Overlaps(kHero, Box(bodies, i)) ? 1 : 0;
+            }
+            hero_brute_time += Clock::now() - start;
+
+            start = Clock::now();
+            int grid_hits = 0;
+            grid.Query(kHero, kCategory, [&grid_hits](int) {
+                grid_hits++;
+                return true;
+            });
+            hero_grid_time += Clock::now() - start;
+            same = same && brute_hits == grid_hits;
+
+            start = Clock::now();
+            long long brute_pairs = 0;
+            for (int i = 0; i < count; ++i) {
+                const SDL_FRect a = Box(bodies, i);
+                for (int j = i + 1; j < count; ++j) {
+                    brute_pairs += Overlaps(a, Box(bodies, j)) ? 1 : 0;
+                }
+            }
+            pairs_brute_time += Clock::now() - start;
+
+            start = Clock::now();
+            grid.QueryPairs(kCategory, kCategory, &pairs);
+            pairs_grid_time += Clock::now() - start;
+            same = same && brute_pairs == static_cast<long long>(pairs.size());
+            pair_total += brute_pairs;
+        }
+
+        std::printf("%8d %10.2f %12.2f %12.2f %14.2f %14.2f %10lld %6s\n", count, Micros(update_time) / ticks,
+                    Micros(hero_brute_time) / ticks, Micros(hero_grid_time) / ticks, Micros(pairs_brute_time) / ticks,
+                    Micros(pairs_grid_time) / ticks, pair_total / ticks, same ? "yes" : "NO");
+    }
+    return 0;
+}
@@ -0,0 +1,140 @@
+// Times BMFont descriptor loading for the game's fonts: the previous
+// getline/substr/stoi scanner, the single-pass XML parser and the binary v3
+// format tools/FontCompiler writes. "load" columns include opening the file,
+// "parse" columns start from bytes already in memory. The binary input is
+// compiled from the XML on the fly, so no packed assets are needed.
+//
+// Usage: font_load_bench [iterations]
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "game/AssetIds.h"
+#include "game/FontFormat.h"
+#include "game/MappedFile.h"
+
+namespace {
+// The loader BitmapFont used before FontFormat, kept for comparison.
+bool LegacyAttribute(const std::string& line, const std::string& key, int* value) {
+    const std::string token = key + "=\"";
+    const std::size_t start = line.find(token);
+    if (start == std::string::npos) {
+        return false;
+    }
+    const std::size_t value_start = start + token.size();
+    const std::size_t value_end = line.find('"', value_start);
+    if (value_end == std::string::npos) {
+        return false;
+    }
+    *value = std::stoi(line.substr(value_start, value_end - value_start));
+    return true;
+}
+
+int LegacyParse(std::istream& file) {
+    std::string line;
+    int line_height = 0;
+    int glyphs = 0;
+    while (std::getline(file, line)) {
+        if (line.find("lineHeight") != std::string::npos) {
+            LegacyAttribute(line, "lineHeight", &line_height);
+        }
+        if (line.find("<char ") == std::string::npos) {
+            continue;
+        }
+        int id = 0;
+        int value = 0;
+        if (!LegacyAttribute(line, "id", &id)) {
+            continue;
+        }
+        for (const char* key : {"x", "y", "width", "height", "xoffset", "yoffset", "xadvance"}) {
+            LegacyAttribute(line, key, &value);
+        }
+        glyphs++;
+    }
+    return glyphs;
+}
+
+int LegacyLoad(const std::string& path) {
+    std::ifstream file(path);
+    return LegacyParse(file);
+}
+
+int ParseFile(const std::string& path, FontDescriptor* font) {
+    MappedFile file;
+    if (!file.Open(path) || !ParseFont(file.Data(), file.Size(), font, nullptr)) {
+        return 0;
+    }
+    return static_cast<int>(font->chars.size());
+}
+
+template <typename Fn>
+double MicrosPerCall(int iterations, Fn&& fn) {
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i) {
+        fn();
+    }
+    const std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count() / iterations;
+}
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    const int iterations = (argc > 1) ? std::max(1, std::atoi(argv[1])) : 2000;
+    const std::string binary_path = "font_load_bench.fnt";
+
+    std::printf("%-16s %7s | %-28s | %-28s\n", "", "", "load us (from disk)", "parse us (in memory)");
+    std::printf("%-16s %7s | %8s %8s %10s | %8s %8s %10s\n", "font", "glyphs", "legacy", "xml", "binary", "legacy",
+                "xml", "binary");
+    int failures = 0;
+    for (int i = 0; i < kFontCount; ++i) {
+        const FontPaths& paths = FontSource(static_cast<FontId>(i));
+        MappedFile xml;
+        FontDescriptor font;
+        if (!xml.Open(paths.xml) || !ParseFont(xml.Data(), xml.Size(), &font, nullptr)) {
+            std::fprintf(stderr, "cannot parse %s\n", paths.xml);
+            failures++;
+            continue;
+        }
+        const int glyphs = static_cast<int>(font.chars.size());
+        const std::string xml_text(reinterpret_cast<const char*>(xml.Data()), xml.Size());
+        std::vector<unsigned char> blob;
+        WriteFontBinary(font, &blob);
+        std::FILE* file = std::fopen(binary_path.c_str(), "wb");
+        if (!file || std::fwrite(blob.data(), 1, blob.size(), file) != blob.size()) {
+            std::fprintf(stderr, "cannot write %s\n", binary_path.c_str());
+            return 1;
+        }
+        std::fclose(file);
+
+        int sink = 0;
+        const double legacy_load = MicrosPerCall(iterations, [&] { sink += LegacyLoad(paths.xml); });
+        const double xml_load = MicrosPerCall(iterations, [&] { sink += ParseFile(paths.xml, &font); });
+        const double binary_load = MicrosPerCall(iterations, [&] { sink += ParseFile(binary_path, &font); });
+        const double legacy_parse = MicrosPerCall(iterations, [&] {
+            std::istringstream stream(xml_text);
+            sink += LegacyParse(stream);
+        });
+        const double xml_parse = MicrosPerCall(iterations, [&] {
+            ParseFont(xml.Data(), xml.Size(), &font, nullptr);
+            sink += static_cast<int>(font.chars.size());
+        });
+        const double binary_parse = MicrosPerCall(iterations, [&] {
+            ParseFont(blob.data(), blob.size(), &font, nullptr);
+            sink += static_cast<int>(font.chars.size());
+        });
+        if (sink != 6 * iterations * glyphs) {
+            std::fprintf(stderr, "%s: loaders disagree on the glyph count\n", paths.xml);
+            failures++;
+        }
+        std::printf("%-16s %7d | %8.2f %8.2f %10.2f | %8.2f %8.2f %10.2f\n", font.face.c_str(), glyphs, legacy_load,
+                    xml_load, binary_load, legacy_parse, xml_parse, binary_parse);
+    }
+    std::remove(binary_path.c_str());
+    return failures == 0 ? 0 : 1;
+}
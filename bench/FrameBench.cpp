@@ -0,0 +1,95 @@
+// Renders a run of gameplay frames offscreen and reports draw calls, texture
+// switches and render state changes per frame, plus resident texture memory at the end: with
+// loose PNG textures, with the packed atlas from pack_assets.sh, and with the
+// atlas plus the prescaled full-screen layers. A last pass repeats the
+// prescaled one under a 1 MB texture budget and counts the evictions: the
+// menu's atlas page and the unused land layers go once the run starts.
+//
+// Usage: frame_bench [frames]
+
+#include <SDL2/SDL.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+
+#include "game/Game.h"
+#include "game/RenderStats.h"
+#include "game/states/GameState.h"
+
+namespace {
+struct BenchResult {
+    double draw_calls = 0.0;
+    double texture_switches = 0.0;
+    double state_changes = 0.0;
+    double frame_ms = 0.0;
+    double texture_mb = 0.0;
+    int evictions = 0;
+};
+
+bool RunPass(bool use_atlas, bool use_prescaled, int budget_mb, int frames, BenchResult* out_result) {
+    Game game;
+    game.GetAssets().SetAtlasEnabled(use_atlas);
+    GameConfig config;
+    config.async_preload = false;  // the benchmark needs every asset before its first frame
+    config.prescaled_textures = use_prescaled;
+    config.texture_budget_mb = budget_mb;
+    if (!game.Init(config)) {
+        std::fprintf(stderr, "init failed: %s\n", SDL_GetError());
+        return false;
+    }
+    game.ChangeState(std::make_unique<GameState>(0, 0));
+
+    const float delta_seconds = 1.0f / 60.0f;
+    long long draw_calls = 0;
+    long long texture_switches = 0;
+    long long state_changes = 0;
+    const Uint64 start = SDL_GetPerformanceCounter();
+    for (int i = 0; i < frames; ++i) {
+        game.Frame(delta_seconds);
+        draw_calls += FrameRenderStats().draw_calls;
+        texture_switches += FrameRenderStats().texture_switches;
+        state_changes += FrameRenderStats().state_changes;
+    }
+    const Uint64 elapsed = SDL_GetPerformanceCounter() - start;
+
+    out_result->draw_calls = static_cast<double>(draw_calls) / frames;
+    out_result->texture_switches = static_cast<double>(texture_switches) / frames;
+    out_result->state_changes = static_cast<double>(state_changes) / frames;
+    out_result->frame_ms = static_cast<double>(elapsed) * 1000.0 / static_cast<double>(SDL_GetPerformanceFrequency()) / frames;
+    out_result->texture_mb = static_cast<double>(game.GetAssets().ResidentTextureBytes()) / (1024.0 * 1024.0);
+    out_result->evictions = game.GetAssets().TextureEvictions();
+    return true;
+}
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    const int frames = (argc > 1) ? std::max(1, std::atoi(argv[1])) : 600;
+
+    SDL_setenv("SDL_VIDEODRIVER", "dummy", 0);
+    SDL_setenv("SDL_AUDIODRIVER", "dummy", 0);
+
+    BenchResult loose;
+    BenchResult atlas;
+    BenchResult prescaled;
+    BenchResult budget;
+    if (!RunPass(false, false, 0, frames, &loose) || !RunPass(true, false, 0, frames, &atlas) ||
+        !RunPass(true, true, 0, frames, &prescaled) || !RunPass(true, true, 1, frames, &budget)) {
+        return 1;
+    }
+
+    std::printf("frames: %d\n", frames);
+    std::printf("%-9s %12s %18s %17s %10s %11s %10s\n", "mode", "draws/frame", "tex switches/frame",
+                "state chg/frame", "ms/frame", "texture MB", "evictions");
+    const auto print_row = [](const char* mode, const BenchResult& result) {
+        std::printf("%-9s %12.1f %18.1f %17.1f %10.3f %11.1f %10d\n", mode, result.draw_calls,
+                    result.texture_switches, result.state_changes, result.frame_ms, result.texture_mb,
+                    result.evictions);
+    };
+    print_row("loose", loose);
+    print_row("atlas", atlas);
+    print_row("prescaled", prescaled);
+    print_row("budget", budget);
+    return 0;
+}
@@ -0,0 +1,147 @@
+// Runs GameState's update path without a window or audio device and reports
+// simulation throughput plus per-subsystem timings. A seeded bot taps left and
+// right so the hero moves; after each death the run restarts with a fresh
+// GameState. Build with ENABLE_PROFILER (build_tools.sh does) for the zones.
+// `stress` multiplies every spawn (see --stress) to load the entity pools;
+// `sim_hz` overrides the tick rate (see --sim-hz). `record_file` records the
+// runs (see --record); it keeps the last one, cut off where the sim stops,
+// for replay_sim.
+//
+// Usage: headless_sim [minutes] [seed] [stress] [sim_hz] [record_file]
+
+#include <SDL2/SDL.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <random>
+
+#include "game/Constants.h"
+#include "game/Game.h"
+#include "game/Profiler.h"
+#include "game/Random.h"
+#include "game/states/GameState.h"
+
+namespace {
+constexpr float kRestartDelay = 1.5f;
+
+class InputBot {
+public:
+    explicit InputBot(unsigned int seed) : rng_(seed) {}
+
+    void Update(Game& game, float delta_seconds) {
+        timer_ -= delta_seconds;
+        if (timer_ > 0.0f) {
+            return;
+        }
+        timer_ = std::uniform_real_distribution<float>(0.2f, 1.2f)(rng_);
+
+        SDL_Event event{};
+        if (pressed_) {
+            event.type = SDL_MOUSEBUTTONUP;
+        } else {
+            event.type = SDL_MOUSEBUTTONDOWN;
+            event.button.x = std::uniform_int_distribution<int>(0, constants::kScreenWidth - 1)(rng_);
+            event.button.y = constants::kScreenHeight / 2;
+        }
+        pressed_ = !pressed_;
+        game.DispatchEvent(event);
+    }
+
+private:
+    std::mt19937 rng_;
+    float timer_ = 0.0f;
+    bool pressed_ = false;
+};
+
+GameState* StartRun(Game& game) {
+    auto state = std::make_unique<GameState>(0, 0);
+    GameState* raw = state.get();
+    game.ChangeState(std::move(state));
+    return raw;
+}
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    const double minutes = (argc > 1) ? std::atof(argv[1]) : 10.0;
+    const unsigned int seed = (argc > 2) ? static_cast<unsigned int>(std::strtoul(argv[2], nullptr, 10)) : 1u;
+    const int stress = (argc > 3) ? std::max(1, std::atoi(argv[3])) : 1;
+
+    GameConfig config;
+    config.headless = true;
+    config.seed = seed;
+    config.spawn_multiplier = stress;
+    if (argc > 4) {
+        config.sim_hz = std::max(1, std::atoi(argv[4]));
+    }
+    if (argc > 5) {
+        config.record_path = argv[5];
+    }
+
+    Game game;
+    if (!game.Init(config)) {
+        std::fprintf(stderr, "headless init failed: %s\n", SDL_GetError());
+        return 1;
+    }
+
+    const float step = game.StepSeconds();
+    const long long total_ticks = static_cast<long long>(minutes * 60.0 * game.Config().sim_hz + 0.5);
+    InputBot bot(seed ^ 0x9e3779b9u);
+    GameState* state = StartRun(game);
+    int runs = 1;
+    int peak_balls = 0;
+    int peak_numbers = 0;
+    float dead_time = 0.0f;
+
+    Profiler::Get().Reset();
+    Uint64 tick_counter = 0;
+    const Uint64 start = SDL_GetPerformanceCounter();
+    for (long long i = 0; i < total_ticks; ++i) {
+        bot.Update(game, step);
+
+        const Uint64 tick_start = SDL_GetPerformanceCounter();
+        game.Tick();
+        tick_counter += SDL_GetPerformanceCounter() - tick_start;
+        peak_balls = std::max(peak_balls, state->BallCount());
+        peak_numbers = std::max(peak_numbers, state->NumberCount());
+
+        if (state->IsDead()) {
+            dead_time += step;
+            if (dead_time >= kRestartDelay) {
+                state = StartRun(game);
+                dead_time = 0.0f;
+                runs++;
+            }
+        }
+    }
+    const Uint64 elapsed = SDL_GetPerformanceCounter() - start;
+
+    const double frequency = static_cast<double>(SDL_GetPerformanceFrequency());
+    const double wall_seconds = static_cast<double>(elapsed) / frequency;
+    const double tick_ms = static_cast<double>(tick_counter) * 1000.0 / frequency;
+
+    std::printf("seed: %u  simulated: %.1f min  ticks: %lld  runs: %d\n", RandomSeed(), minutes, total_ticks, runs);
+    std::printf("wall: %.3f s  ticks/s: %.0f  realtime factor: %.1fx\n", wall_seconds,
+                static_cast<double>(total_ticks) / wall_seconds, minutes * 60.0 / wall_seconds);
+    std::printf("tick total: %.3f ms  avg: %.3f us\n", tick_ms, tick_ms * 1000.0 / static_cast<double>(total_ticks));
+    std::printf("peak balls: %d  peak numbers: %d  (stress x%d)\n", peak_balls, peak_numbers, stress);
+
+#if defined(ENABLE_PROFILER)
+    std::printf("%-16s %12s %12s %10s\n", "zone", "total ms", "avg us", "% of tick");
+    for (int i = 0; i < kProfileZoneCount; ++i) {
+        const ProfileZone zone = static_cast<ProfileZone>(i);
+        const Uint64 calls = Profiler::Get().Calls(zone);
+        if (calls == 0) {
+            continue;  // render/frame zones never run here
+        }
+        const double zone_ms = static_cast<double>(Profiler::Get().TotalTicks(zone)) * 1000.0 / frequency;
+        std::printf("%-16s %12.3f %12.3f %9.1f%%\n", Profiler::ZoneName(zone), zone_ms,
+                    calls > 0 ? zone_ms * 1000.0 / static_cast<double>(calls) : 0.0,
+                    tick_ms > 0.0 ? zone_ms * 100.0 / tick_ms : 0.0);
+    }
+#else
+    std::printf("(per-zone timings need -DENABLE_PROFILER)\n");
+#endif
+    return 0;
+}
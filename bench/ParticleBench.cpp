@@ -0,0 +1,87 @@
+// Times ParticleSystem's integrate-and-cull kernels on death bursts: the plain
+// scalar loop against the SSE2/NEON one, at the stock density and 10x. Each
+// repetition emits one burst of every emitter and steps it at the simulation
+// rate until the last particle dies. A lockstep pass first checks the kernels
+// keep the same particles alive on every step.
+//
+// Usage: particle_bench [repetitions]
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+
+#include "game/Constants.h"
+#include "game/ParticleSystem.h"
+#include "game/Random.h"
+
+namespace {
+constexpr unsigned int kSeed = 1234u;
+
+void EmitBurst(ParticleSystem* system, int density) {
+    for (int i = 0; i < static_cast<int>(EmitterId::kCount); ++i) {
+        system->Emit(static_cast<EmitterId>(i), 608.0f, 570.0f, density);
+    }
+}
+
+bool KernelsAgree(int density, float step) {
+    auto scalar = std::make_unique<ParticleSystem>();
+    auto simd = std::make_unique<ParticleSystem>();
+    SeedRandom(kSeed);
+    EmitBurst(scalar.get(), density);
+    SeedRandom(kSeed);
+    EmitBurst(simd.get(), density);
+    while (scalar->Count() > 0 || simd->Count() > 0) {
+        scalar->UpdateScalar(step);
+        simd->UpdateSimd(step);
+        if (scalar->Count() != simd->Count()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Returns nanoseconds per particle-step.
+double TimeKernel(bool use_simd, int density, int repetitions, float step) {
+    auto system = std::make_unique<ParticleSystem>();
+    long long particle_steps = 0;
+    std::chrono::nanoseconds elapsed{0};
+    SeedRandom(kSeed);
+    for (int r = 0; r < repetitions; ++r) {
+        EmitBurst(system.get(), density);
+        const auto start = std::chrono::steady_clock::now();
+        while (system->Count() > 0) {
+            particle_steps += system->Count();
+            if (use_simd) {
+                system->UpdateSimd(step);
+            } else {
+                system->UpdateScalar(step);
+            }
+        }
+        elapsed += std::chrono::steady_clock::now() - start;
+    }
+    return particle_steps > 0 ? static_cast<double>(elapsed.count()) / static_cast<double>(particle_steps) : 0.0;
+}
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    const int repetitions = (argc > 1) ? std::max(1, std::atoi(argv[1])) : 200;
+    const float step = 1.0f / static_cast<float>(constants::kSimHz);
+
+    std::printf("repetitions: %d  simd kernel: %s\n", repetitions, ParticleSystem::SimdKernelName());
+    std::printf("%-8s %10s %8s %14s %12s %8s\n", "density", "particles", "agree", "scalar ns/p", "simd ns/p", "speedup");
+    const int densities[] = {1, 10};
+    for (int density : densities) {
+        int burst = 0;
+        for (int i = 0; i < static_cast<int>(EmitterId::kCount); ++i) {
+            burst += Emitter(static_cast<EmitterId>(i)).count * density;
+        }
+        const bool agree = KernelsAgree(density, step);
+        const double scalar_ns = TimeKernel(false, density, repetitions, step);
+        const double simd_ns = TimeKernel(true, density, repetitions, step);
+        std::printf("%-8d %10d %8s %14.2f %12.2f %7.2fx\n", density, burst, agree ? "yes" : "NO", scalar_ns, simd_ns,
+                    simd_ns > 0.0 ? scalar_ns / simd_ns : 0.0);
+    }
+    return 0;
+}
@@ -0,0 +1,96 @@
+// Plays a recorded run (--record, or headless_sim's record_file argument)
+// headless and as fast as possible, then reports tick timings and whether the
+// run ended on the recorded tick with the recorded score. Replaying the same
+// file before and after a change times an identical workload. Build with
+// ENABLE_PROFILER (build_tools.sh does) for the zones.
+//
+// Usage: replay_sim file [repeats]
+
+#include <SDL2/SDL.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+
+#include "game/Game.h"
+#include "game/Profiler.h"
+
+namespace {
+struct PlaybackResult {
+    bool ok = false;
+    bool matched = false;
+    long long ticks = 0;
+    Uint64 tick_counter = 0;
+};
+
+PlaybackResult Play(const char* path) {
+    PlaybackResult result;
+    GameConfig config;
+    config.headless = true;
+    config.replay_path = path;
+
+    // Init goes straight into the recorded run.
+    Game game;
+    if (!game.Init(config)) {
+        std::fprintf(stderr, "replay init failed: %s\n", SDL_GetError());
+        return result;
+    }
+    while (!game.Replay().Finished()) {
+        const Uint64 tick_start = SDL_GetPerformanceCounter();
+        game.Tick();
+        result.tick_counter += SDL_GetPerformanceCounter() - tick_start;
+        result.ticks++;
+    }
+    // Ends the run, which checks it against the recording.
+    game.Shutdown();
+    result.ok = true;
+    result.matched = game.Replay().Matched();
+    return result;
+}
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        std::fprintf(stderr, "usage: %s file [repeats]\n", argv[0]);
+        return 1;
+    }
+    const int repeats = (argc > 2) ? std::max(1, std::atoi(argv[2])) : 1;
+
+    Profiler::Get().Reset();
+    PlaybackResult total;
+    bool matched = true;
+    for (int r = 0; r < repeats; ++r) {
+        const PlaybackResult result = Play(argv[1]);
+        if (!result.ok) {
+            return 1;
+        }
+        matched = matched && result.matched;
+        total.ticks += result.ticks;
+        total.tick_counter += result.tick_counter;
+    }
+
+    const double frequency = static_cast<double>(SDL_GetPerformanceFrequency());
+    const double tick_ms = static_cast<double>(total.tick_counter) * 1000.0 / frequency;
+    std::printf("replay: %s  repeats: %d  ticks: %lld  matched: %s\n", argv[1], repeats, total.ticks / repeats,
+                matched ? "yes" : "NO");
+    std::printf("tick total: %.3f ms  avg: %.3f us\n", tick_ms,
+                total.ticks > 0 ? tick_ms * 1000.0 / static_cast<double>(total.ticks) : 0.0);
+
+#if defined(ENABLE_PROFILER)
+    std::printf("%-16s %12s %12s %10s\n", "zone", "total ms", "avg us", "% of tick");
+    for (int i = 0; i < kProfileZoneCount; ++i) {
+        const ProfileZone zone = static_cast<ProfileZone>(i);
+        const Uint64 calls = Profiler::Get().Calls(zone);
+        if (calls == 0) {
+            continue;
+        }
+        const double zone_ms = static_cast<double>(Profiler::Get().TotalTicks(zone)) * 1000.0 / frequency;
+        std::printf("%-16s %12.3f %12.3f %9.1f%%\n", Profiler::ZoneName(zone), zone_ms,
+                    zone_ms * 1000.0 / static_cast<double>(calls), tick_ms > 0.0 ? zone_ms * 100.0 / tick_ms : 0.0);
+    }
+#else
+    std::printf("(per-zone timings need -DENABLE_PROFILER)\n");
+#endif
+    return matched ? 0 : 2;
+}
@@ -1,20 +1,42 @@
 #!/bin/sh
 set -e
 
+# PROFILE=1 ./build_and_run.sh --profile builds with the profiler overlay/trace.
 g++ -std=c++17 \
   src/main.cpp \
   src/game/Game.cpp \
+  src/game/GameConfig.cpp \
+  src/game/AssetArchive.cpp \
+  src/game/AssetLoader.cpp \
+  src/game/BackgroundCache.cpp \
+  src/game/Broadphase.cpp \
+  src/game/Collision.cpp \
+  src/game/EntityPool.cpp \
+  src/game/InputReplay.cpp \
+  src/game/ParticleSystem.cpp \
+  src/game/RenderQueue.cpp \
   src/game/Assets.cpp \
   src/game/BitmapFont.cpp \
+  src/game/FontFormat.cpp \
   src/game/Json.cpp \
+  src/game/MappedFile.cpp \
+  src/game/Profiler.cpp \
+  src/game/ProfilerOverlay.cpp \
+  src/game/Random.cpp \
   src/game/ScoreStorage.cpp \
-  src/game/StickmanSkeleton.cpp \
+  src/game/SkeletonData.cpp \
+  src/game/SkeletonFormat.cpp \
+  src/game/SkeletonInstance.cpp \
+  src/game/SoundBankFormat.cpp \
+  src/game/VoiceManager.cpp \
   src/game/states/BootState.cpp \
   src/game/states/PreloadState.cpp \
   src/game/states/MenuState.cpp \
   src/game/states/GameState.cpp \
   src/game/states/ResultState.cpp \
   -I./src \
+  -pthread \
+  ${PROFILE:+-DENABLE_PROFILER} \
   $(pkg-config --cflags --libs sdl2 SDL2_image SDL2_mixer) \
   -o attack_on_ball
-./attack_on_ball
+./attack_on_ball "$@"
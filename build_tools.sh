@@ -0,0 +1,66 @@
+#!/bin/sh
+set -e
+
+GAME_SOURCES="
+  src/game/Game.cpp
+  src/game/GameConfig.cpp
+  src/game/AssetArchive.cpp
+  src/game/AssetLoader.cpp
+  src/game/BackgroundCache.cpp
+  src/game/Broadphase.cpp
+  src/game/Collision.cpp
+  src/game/EntityPool.cpp
+  src/game/InputReplay.cpp
+  src/game/ParticleSystem.cpp
+  src/game/RenderQueue.cpp
+  src/game/Assets.cpp
+  src/game/BitmapFont.cpp
+  src/game/FontFormat.cpp
+  src/game/Json.cpp
+  src/game/MappedFile.cpp
+  src/game/Profiler.cpp
+  src/game/ProfilerOverlay.cpp
+  src/game/Random.cpp
+  src/game/ScoreStorage.cpp
+  src/game/SkeletonData.cpp
+  src/game/SkeletonFormat.cpp
+  src/game/SkeletonInstance.cpp
+  src/game/SoundBankFormat.cpp
+  src/game/VoiceManager.cpp
+  src/game/states/BootState.cpp
+  src/game/states/PreloadState.cpp
+  src/game/states/MenuState.cpp
+  src/game/states/GameState.cpp
+  src/game/states/ResultState.cpp
+"
+SDL_FLAGS="$(pkg-config --cflags --libs sdl2 SDL2_image SDL2_mixer) -pthread"
+
+mkdir -p tools/bin
+
+g++ -std=c++17 -O2 tools/AtlasPacker.cpp $SDL_FLAGS -o tools/bin/atlas_packer
+
+g++ -std=c++17 -O2 tools/TexturePrescaler.cpp -I./src $SDL_FLAGS -o tools/bin/texture_prescaler
+
+g++ -std=c++17 -O2 tools/SkeletonCompiler.cpp src/game/SkeletonFormat.cpp src/game/Json.cpp src/game/AssetArchive.cpp \
+  src/game/MappedFile.cpp -I./src -o tools/bin/skeleton_compiler
+
+g++ -std=c++17 -O2 tools/ArchivePacker.cpp src/game/AssetArchive.cpp src/game/MappedFile.cpp -I./src \
+  -o tools/bin/archive_packer
+
+g++ -std=c++17 -O2 tools/FontCompiler.cpp src/game/FontFormat.cpp src/game/MappedFile.cpp -I./src -o tools/bin/font_compiler
+
+g++ -std=c++17 -O2 tools/SoundBankCompiler.cpp src/game/SoundBankFormat.cpp -I./src $SDL_FLAGS \
+  -o tools/bin/sound_bank_compiler
+
+g++ -std=c++17 -O2 bench/FrameBench.cpp $GAME_SOURCES -I./src $SDL_FLAGS -o tools/bin/frame_bench
+
+g++ -std=c++17 -O2 bench/FontLoadBench.cpp src/game/FontFormat.cpp src/game/MappedFile.cpp -I./src \
+  -o tools/bin/font_load_bench
+
+g++ -std=c++17 -O2 -DENABLE_PROFILER bench/HeadlessSim.cpp $GAME_SOURCES -I./src $SDL_FLAGS -o tools/bin/headless_sim
+
+g++ -std=c++17 -O2 bench/ParticleBench.cpp $GAME_SOURCES -I./src $SDL_FLAGS -o tools/bin/particle_bench
+
+g++ -std=c++17 -O2 bench/BroadphaseBench.cpp src/game/Broadphase.cpp -I./src $SDL_FLAGS -o tools/bin/broadphase_bench
+
+g++ -std=c++17 -O2 -DENABLE_PROFILER bench/ReplaySim.cpp $GAME_SOURCES -I./src $SDL_FLAGS -o tools/bin/replay_sim
@@ -0,0 +1,48 @@
+#!/bin/sh
+set -e
+
+./build_tools.sh
+mkdir -p assets/packed
+
+# Full-screen layers at output resolution, opaque ones dithered to RGB565.
+# They load on their own, so the atlas leaves them out (as well as
+# LaunchAndroid.png, which the game never loads).
+mkdir -p assets/packed/prescaled
+tools/bin/texture_prescaler assets/packed --rgb565
+PRESCALED=$(awk '/^texture/ { print "assets/" $2 ".png" }' assets/packed/Prescaled.txt)
+# One page group per texture set (Assets.cpp's kMenuTextures and friends;
+# keep the two in step), so a set's pages load and evict with the set
+# instead of being pinned by whatever shares them. Font pages are held for
+# good and go first; sprites in no group share the last pages.
+FONT_GROUP="NumberTime NumberScoreMain NumberScoreEnd"
+MENU_GROUP="Title TouchToPlay Colon"
+SHARED_GROUP="Shadow Stickman Dot WordBest ButtonGamecenter0 ButtonGamecenter1 ButtonShare0 ButtonShare1"
+GAMEPLAY_GROUP="Ball0 Ball1 Ball2 Ball3 Ball4 NumberItem1 NumberItem2 NumberItem3 NumberItem4 Gauge GaugeHead White4
+  EffectHit WordYour ButtonPlay0 ButtonPlay1"
+DEATH_GROUP="Blood DeadParts0 DeadParts1 DeadParts2 DeadParts3 DeadParts4 DeadParts5 DeadParts6 DeadParts7
+  EffectBlood0 EffectBlood1 EffectBlood2 EffectBlood3 EffectBlood4 EffectBlood5 EffectBlood6 EffectBlood7
+  EffectBlood8 EffectBlood9 EffectBlood10"
+PACKABLE=$(ls assets/*.png | grep -v LaunchAndroid | grep -vxF "$PRESCALED")
+GROUPED=""
+ATLAS_ARGS=""
+for group in "$FONT_GROUP" "$MENU_GROUP" "$SHARED_GROUP" "$GAMEPLAY_GROUP" "$DEATH_GROUP"; do
+  for name in $group; do
+    if echo "$PACKABLE" | grep -qxF "assets/$name.png"; then
+      ATLAS_ARGS="$ATLAS_ARGS assets/$name.png"
+      GROUPED="$GROUPED
+assets/$name.png"
+    fi
+  done
+  ATLAS_ARGS="$ATLAS_ARGS --"
+done
+ATLAS_ARGS="$ATLAS_ARGS $(echo "$PACKABLE" | grep -vxF "$GROUPED")"
+tools/bin/atlas_packer assets/packed 2048 $ATLAS_ARGS
+tools/bin/skeleton_compiler assets/Stickman.json assets/Stickman.atlas assets/packed/Stickman.skel
+for font in NumberTime NumberScoreMain NumberScoreEnd; do
+  tools/bin/font_compiler assets/$font.xml assets/packed/$font.fnt
+done
+tools/bin/sound_bank_compiler assets/packed/Sounds.bank
+
+# Last, so the archive picks up everything generated above.
+rm -f assets/packed/Assets.pak
+tools/bin/archive_packer assets/packed/Assets.pak $(find assets -type f ! -name LaunchAndroid.png | sort)
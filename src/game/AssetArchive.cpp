@@ -0,0 +1,143 @@
+#include "AssetArchive.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace {
+const AssetArchive* g_mounted_archive = nullptr;
+
+template <typename T>
+void Patch(std::vector<unsigned char>* blob, std::size_t offset, const T& value) {
+    std::memcpy(blob->data() + offset, &value, sizeof(T));
+}
+
+void AlignBlob(std::vector<unsigned char>* blob, std::size_t alignment) {
+    while (blob->size() % alignment != 0) {
+        blob->push_back(0);
+    }
+}
+}  // namespace
+
+void WriteArchive(std::vector<ArchiveFile> files, std::vector<unsigned char>* out_blob) {
+    std::sort(files.begin(), files.end(), [](const ArchiveFile& a, const ArchiveFile& b) { return a.path < b.path; });
+
+    std::vector<unsigned char>& blob = *out_blob;
+    blob.assign(sizeof(ArchiveHeader), 0);
+    ArchiveHeader header{};
+    header.magic = kArchiveMagic;
+    header.version = kArchiveVersion;
+    header.entry_count = static_cast<std::uint32_t>(files.size());
+
+    std::vector<ArchiveEntryRecord> records(files.size());
+    std::string strings;
+    for (std::size_t i = 0; i < files.size(); ++i) {
+        records[i].name = static_cast<std::uint32_t>(strings.size());
+        strings += files[i].path;
+        strings += '\0';
+    }
+
+    header.entries_offset = static_cast<std::uint32_t>(blob.size());
+    blob.resize(blob.size() + records.size() * sizeof(ArchiveEntryRecord));
+    header.strings_offset = static_cast<std::uint32_t>(blob.size());
+    header.string_bytes = static_cast<std::uint32_t>(strings.size());
+    blob.insert(blob.end(), strings.begin(), strings.end());
+
+    for (std::size_t i = 0; i < files.size(); ++i) {
+        AlignBlob(&blob, kArchiveDataAlignment);
+        records[i].data_offset = static_cast<std::uint32_t>(blob.size());
+        records[i].data_bytes = static_cast<std::uint32_t>(files[i].data.size());
+        blob.insert(blob.end(), files[i].data.begin(), files[i].data.end());
+    }
+
+    header.size = static_cast<std::uint32_t>(blob.size());
+    Patch(&blob, 0, header);
+    for (std::size_t i = 0; i < records.size(); ++i) {
+        Patch(&blob, header.entries_offset + i * sizeof(ArchiveEntryRecord), records[i]);
+    }
+}
+
+bool AssetArchive::Open(const std::string& path) {
+    Close();
+    if (!file_.Open(path)) {
+        return false;
+    }
+    const unsigned char* base = file_.Data();
+    const std::size_t size = file_.Size();
+    const ArchiveHeader* header = reinterpret_cast<const ArchiveHeader*>(base);
+    if (size < sizeof(ArchiveHeader) || header->magic != kArchiveMagic || header->version != kArchiveVersion ||
+        header->size != size || header->entries_offset % 4 != 0 || header->entries_offset > size ||
+        (size - header->entries_offset) / sizeof(ArchiveEntryRecord) < header->entry_count ||
+        header->strings_offset > size || size - header->strings_offset < header->string_bytes) {
+        file_.Close();
+        return false;
+    }
+    const ArchiveEntryRecord* entries = reinterpret_cast<const ArchiveEntryRecord*>(base + header->entries_offset);
+    const char* strings = reinterpret_cast<const char*>(base + header->strings_offset);
+    bool valid = header->entry_count == 0 || (header->string_bytes > 0 && strings[header->string_bytes - 1] == '\0');
+    for (std::uint32_t i = 0; valid && i < header->entry_count; ++i) {
+        const ArchiveEntryRecord& entry = entries[i];
+        valid = entry.name < header->string_bytes && entry.data_offset <= size &&
+                size - entry.data_offset >= entry.data_bytes &&
+                (i == 0 || std::strcmp(strings + entries[i - 1].name, strings + entry.name) < 0);
+    }
+    if (!valid) {
+        file_.Close();
+        return false;
+    }
+    header_ = header;
+    entries_ = entries;
+    strings_ = strings;
+    return true;
+}
+
+void AssetArchive::Close() {
+    file_.Close();
+    header_ = nullptr;
+    entries_ = nullptr;
+    strings_ = nullptr;
+}
+
+bool AssetArchive::Find(const std::string& path, const unsigned char** out_data, std::size_t* out_size) const {
+    if (!header_) {
+        return false;
+    }
+    const ArchiveEntryRecord* end = entries_ + header_->entry_count;
+    const ArchiveEntryRecord* entry =
+        std::lower_bound(entries_, end, path, [this](const ArchiveEntryRecord& record, const std::string& key) {
+            return std::strcmp(strings_ + record.name, key.c_str()) < 0;
+        });
+    if (entry == end || path != strings_ + entry->name) {
+        return false;
+    }
+    *out_data = file_.Data() + entry->data_offset;
+    *out_size = entry->data_bytes;
+    return true;
+}
+
+void MountAssetArchive(const AssetArchive* archive) {
+    g_mounted_archive = archive;
+}
+
+const AssetArchive* MountedAssetArchive() {
+    return g_mounted_archive;
+}
+
+bool AssetFile::Open(const std::string& path) {
+    Close();
+    const AssetArchive* archive = MountedAssetArchive();
+    if (archive && archive->Find(path, &data_, &size_)) {
+        return true;
+    }
+    if (!loose_.Open(path)) {
+        return false;
+    }
+    data_ = loose_.Data();
+    size_ = loose_.Size();
+    return true;
+}
+
+void AssetFile::Close() {
+    loose_.Close();
+    data_ = nullptr;
+    size_ = 0;
+}
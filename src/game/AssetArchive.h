@@ -0,0 +1,86 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "MappedFile.h"
+
+// Packed asset archive, written by tools/ArchivePacker: a header, one record
+// per file sorted by path, a string table, then every file's bytes, 16-byte
+// aligned so compiled formats bind in place. Values are stored little-endian.
+
+constexpr std::uint32_t kArchiveMagic = 0x4b415041;  // "APAK"
+constexpr std::uint32_t kArchiveVersion = 1;
+constexpr std::uint32_t kArchiveDataAlignment = 16;
+
+struct ArchiveHeader {
+    std::uint32_t magic;
+    std::uint32_t version;
+    std::uint32_t size;
+    std::uint32_t entry_count;
+    std::uint32_t string_bytes;
+    std::uint32_t entries_offset;
+    std::uint32_t strings_offset;
+};
+
+struct ArchiveEntryRecord {
+    std::uint32_t name;  // path as the game asks for it, e.g. "assets/Ball0.png"
+    std::uint32_t data_offset;
+    std::uint32_t data_bytes;
+};
+
+struct ArchiveFile {
+    std::string path;
+    std::vector<unsigned char> data;
+};
+
+// Sorts `files` by path and serialises them.
+void WriteArchive(std::vector<ArchiveFile> files, std::vector<unsigned char>* out_blob);
+
+// A mapped archive. Lookups are a binary search over the entry table and
+// return pointers into the mapping, valid until Close.
+class AssetArchive {
+public:
+    // Maps `path` and validates the header and every entry once.
+    bool Open(const std::string& path);
+    void Close();
+
+    bool IsOpen() const { return header_ != nullptr; }
+    int EntryCount() const { return header_ ? static_cast<int>(header_->entry_count) : 0; }
+    bool Find(const std::string& path, const unsigned char** out_data, std::size_t* out_size) const;
+
+private:
+    MappedFile file_;
+    const ArchiveHeader* header_ = nullptr;
+    const ArchiveEntryRecord* entries_ = nullptr;
+    const char* strings_ = nullptr;
+};
+
+// The archive asset reads check before falling back to the loose file. Set by
+// Assets before anything loads and cleared after everything is freed; it is
+// only read afterwards, so preload workers can share it.
+void MountAssetArchive(const AssetArchive* archive);
+const AssetArchive* MountedAssetArchive();
+
+// Read-only bytes of one asset: a view into the mounted archive when the file
+// is packed, otherwise the loose file mapped from disk.
+class AssetFile {
+public:
+    AssetFile() = default;
+    AssetFile(const AssetFile&) = delete;
+    AssetFile& operator=(const AssetFile&) = delete;
+
+    bool Open(const std::string& path);
+    void Close();
+
+    bool IsOpen() const { return data_ != nullptr; }
+    const unsigned char* Data() const { return data_; }
+    std::size_t Size() const { return size_; }
+
+private:
+    MappedFile loose_;
+    const unsigned char* data_ = nullptr;
+    std::size_t size_ = 0;
+};
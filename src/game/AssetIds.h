@@ -0,0 +1,227 @@
+#pragma once
+
+// Asset manifest. Each entry generates an enum ID plus its source path, so the
+// render path indexes assets by integer instead of hashing string keys.
+// Numbered frames must stay adjacent so they can be addressed as first + index
+// (see TextureFrame).
+
+#define ASSET_TEXTURES(X)                                   \
+    X(Bg, "assets/Bg.png")                                  \
+    X(Blood, "assets/Blood.png")                            \
+    X(Colon, "assets/Colon.png")                            \
+    X(Dot, "assets/Dot.png")                                \
+    X(EffectHit, "assets/EffectHit.png")                    \
+    X(Empty, "assets/Empty.png")                            \
+    X(Gauge, "assets/Gauge.png")                            \
+    X(GaugeHead, "assets/GaugeHead.png")                    \
+    X(LandWhite, "assets/LandWhite.png")                    \
+    X(Shadow, "assets/Shadow.png")                          \
+    X(Title, "assets/Title.png")                            \
+    X(TopSign, "assets/TopSign.png")                        \
+    X(TouchToPlay, "assets/TouchToPlay.png")                \
+    X(White4, "assets/White4.png")                          \
+    X(WordBest, "assets/WordBest.png")                      \
+    X(WordYour, "assets/WordYour.png")                      \
+    X(Stickman, "assets/Stickman.png")                      \
+    X(ButtonGamecenter0, "assets/ButtonGamecenter0.png")    \
+    X(ButtonGamecenter1, "assets/ButtonGamecenter1.png")    \
+    X(ButtonPlay0, "assets/ButtonPlay0.png")                \
+    X(ButtonPlay1, "assets/ButtonPlay1.png")                \
+    X(ButtonRate0, "assets/ButtonRate0.png")                \
+    X(ButtonRate1, "assets/ButtonRate1.png")                \
+    X(ButtonShare0, "assets/ButtonShare0.png")              \
+    X(ButtonShare1, "assets/ButtonShare1.png")              \
+    X(NumberItem1, "assets/NumberItem1.png")                \
+    X(NumberItem2, "assets/NumberItem2.png")                \
+    X(NumberItem3, "assets/NumberItem3.png")                \
+    X(NumberItem4, "assets/NumberItem4.png")                \
+    X(Ball0, "assets/Ball0.png")                            \
+    X(Ball1, "assets/Ball1.png")                            \
+    X(Ball2, "assets/Ball2.png")                            \
+    X(Ball3, "assets/Ball3.png")                            \
+    X(Ball4, "assets/Ball4.png")                            \
+    X(Land0, "assets/Land0.png")                            \
+    X(Land1, "assets/Land1.png")                            \
+    X(Land2, "assets/Land2.png")                            \
+    X(Land3, "assets/Land3.png")                            \
+    X(Land4, "assets/Land4.png")                            \
+    X(Land5, "assets/Land5.png")                            \
+    X(DeadParts0, "assets/DeadParts0.png")                  \
+    X(DeadParts1, "assets/DeadParts1.png")                  \
+    X(DeadParts2, "assets/DeadParts2.png")                  \
+    X(DeadParts3, "assets/DeadParts3.png")                  \
+    X(DeadParts4, "assets/DeadParts4.png")                  \
+    X(DeadParts5, "assets/DeadParts5.png")                  \
+    X(DeadParts6, "assets/DeadParts6.png")                  \
+    X(DeadParts7, "assets/DeadParts7.png")                  \
+    X(EffectBlood0, "assets/EffectBlood0.png")              \
+    X(EffectBlood1, "assets/EffectBlood1.png")              \
+    X(EffectBlood2, "assets/EffectBlood2.png")              \
+    X(EffectBlood3, "assets/EffectBlood3.png")              \
+    X(EffectBlood4, "assets/EffectBlood4.png")              \
+    X(EffectBlood5, "assets/EffectBlood5.png")              \
+    X(EffectBlood6, "assets/EffectBlood6.png")              \
+    X(EffectBlood7, "assets/EffectBlood7.png")              \
+    X(EffectBlood8, "assets/EffectBlood8.png")              \
+    X(EffectBlood9, "assets/EffectBlood9.png")              \
+    X(EffectBlood10, "assets/EffectBlood10.png")            \
+    X(NumberTime, "assets/NumberTime.png")                  \
+    X(NumberScoreMain, "assets/NumberScoreMain.png")        \
+    X(NumberScoreEnd, "assets/NumberScoreEnd.png")
+
+// Full-screen layers that tools/TexturePrescaler resamples to the output
+// resolution. They are drawn at design scale only, so nothing is lost, and they
+// stay out of the atlas.
+#define ASSET_PRESCALED_TEXTURES(X) \
+    X(Bg)                           \
+    X(LandWhite)                    \
+    X(Land0)                        \
+    X(Land1)                        \
+    X(Land2)                        \
+    X(Land3)                        \
+    X(Land4)                        \
+    X(Land5)
+
+// Fonts: ID, glyph page texture, binary descriptor (tools/FontCompiler), BMFont
+// XML used when the binary is missing.
+#define ASSET_FONTS(X)                                                                                                 \
+    X(NumberTime, TextureId::kNumberTime, "assets/packed/NumberTime.fnt", "assets/NumberTime.xml")                     \
+    X(NumberScoreMain, TextureId::kNumberScoreMain, "assets/packed/NumberScoreMain.fnt", "assets/NumberScoreMain.xml") \
+    X(NumberScoreEnd, TextureId::kNumberScoreEnd, "assets/packed/NumberScoreEnd.fnt", "assets/NumberScoreEnd.xml")
+
+// Sounds: ID, file, how many copies may play at once, and priority when the
+// voice manager has to steal a channel (higher wins).
+#define ASSET_SOUNDS(X)                                                \
+    X(Foot, "assets/sound/foot.ogg", 2, 1)                             \
+    X(Toss, "assets/sound/toss_03.ogg", 3, 1)                          \
+    X(NumberGet, "assets/sound/numberGet_00.ogg", 3, 2)                \
+    X(NumberGetGauge, "assets/sound/numberGet_gauge00.ogg", 2, 2)      \
+    X(UiButton, "assets/sound/ui_button.ogg", 1, 3)                    \
+    X(Dead02, "assets/sound/dead02.ogg", 1, 4)                         \
+    X(Dead03, "assets/sound/dead03.ogg", 1, 4)                         \
+    X(Die00, "assets/sound/die00.ogg", 1, 5)                           \
+    X(Clock, "assets/sound/clock00.ogg", 1, 3)
+
+// Skeletons: ID, compiled file (tools/SkeletonCompiler), Spine JSON and atlas
+// used when the compiled file is missing.
+#define ASSET_SKELETONS(X) \
+    X(Stickman, "assets/packed/Stickman.skel", "assets/Stickman.json", "assets/Stickman.atlas")
+
+enum class TextureId : int {
+#define ASSET_ID(name, path) k##name,
+    ASSET_TEXTURES(ASSET_ID)
+#undef ASSET_ID
+    kCount
+};
+
+enum class FontId : int {
+#define ASSET_ID(name, texture, compiled, xml) k##name,
+    ASSET_FONTS(ASSET_ID)
+#undef ASSET_ID
+    kCount
+};
+
+enum class SoundId : int {
+#define ASSET_ID(name, path, max_voices, priority) k##name,
+    ASSET_SOUNDS(ASSET_ID)
+#undef ASSET_ID
+    kCount
+};
+
+enum class SkeletonId : int {
+#define ASSET_ID(name, compiled, json, atlas) k##name,
+    ASSET_SKELETONS(ASSET_ID)
+#undef ASSET_ID
+    kCount
+};
+
+constexpr int kTextureCount = static_cast<int>(TextureId::kCount);
+constexpr int kFontCount = static_cast<int>(FontId::kCount);
+constexpr int kSoundCount = static_cast<int>(SoundId::kCount);
+constexpr int kSkeletonCount = static_cast<int>(SkeletonId::kCount);
+
+constexpr TextureId TextureFrame(TextureId first, int index) {
+    return static_cast<TextureId>(static_cast<int>(first) + index);
+}
+
+inline const char* TexturePath(TextureId id) {
+    static constexpr const char* kPaths[] = {
+#define ASSET_PATH(name, path) path,
+        ASSET_TEXTURES(ASSET_PATH)
+#undef ASSET_PATH
+    };
+    return kPaths[static_cast<int>(id)];
+}
+
+inline TextureId FontTexture(FontId id) {
+    static constexpr TextureId kTextures[] = {
+#define ASSET_TEXTURE(name, texture, compiled, xml) texture,
+        ASSET_FONTS(ASSET_TEXTURE)
+#undef ASSET_TEXTURE
+    };
+    return kTextures[static_cast<int>(id)];
+}
+
+struct FontPaths {
+    const char* compiled;
+    const char* xml;
+};
+
+inline const FontPaths& FontSource(FontId id) {
+    static constexpr FontPaths kPaths[] = {
+#define ASSET_PATHS(name, texture, compiled, xml) {compiled, xml},
+        ASSET_FONTS(ASSET_PATHS)
+#undef ASSET_PATHS
+    };
+    return kPaths[static_cast<int>(id)];
+}
+
+inline const char* SoundPath(SoundId id) {
+    static constexpr const char* kPaths[] = {
+#define ASSET_PATH(name, path, max_voices, priority) path,
+        ASSET_SOUNDS(ASSET_PATH)
+#undef ASSET_PATH
+    };
+    return kPaths[static_cast<int>(id)];
+}
+
+struct SoundVoicePolicy {
+    int max_voices;
+    int priority;
+};
+
+inline const SoundVoicePolicy& SoundPolicy(SoundId id) {
+    static constexpr SoundVoicePolicy kPolicies[] = {
+#define ASSET_POLICY(name, path, max_voices, priority) {max_voices, priority},
+        ASSET_SOUNDS(ASSET_POLICY)
+#undef ASSET_POLICY
+    };
+    return kPolicies[static_cast<int>(id)];
+}
+
+// Every sound above, pre-decoded by tools/SoundBankCompiler. Optional: sounds
+// missing from it are decoded from their OGG.
+constexpr const char* kSoundBankPath = "assets/packed/Sounds.bank";
+
+// Written by tools/TexturePrescaler. Optional: without it the layers above
+// load from their full-size PNGs.
+constexpr const char* kPrescaledIndexPath = "assets/packed/Prescaled.txt";
+
+// Everything under assets/ in one file (tools/ArchivePacker). Optional: loads
+// fall back to the loose files.
+constexpr const char* kAssetArchivePath = "assets/packed/Assets.pak";
+
+struct SkeletonPaths {
+    const char* compiled;
+    const char* json;
+    const char* atlas;
+};
+
+inline const SkeletonPaths& SkeletonSource(SkeletonId id) {
+    static constexpr SkeletonPaths kPaths[] = {
+#define ASSET_PATHS(name, compiled, json, atlas) {compiled, json, atlas},
+        ASSET_SKELETONS(ASSET_PATHS)
+#undef ASSET_PATHS
+    };
+    return kPaths[static_cast<int>(id)];
+}
@@ -0,0 +1,282 @@
+#include "AssetLoader.h"
+
+#include <SDL2/SDL_image.h>
+#include <algorithm>
+#include <unordered_map>
+
+namespace {
+constexpr int kMaxWorkers = 4;
+
+// Converts on the worker so SDL_CreateTextureFromSurface can upload without
+// touching the pixels again. `format` comes from Assets::TextureFileFormat;
+// otherwise images with transparency keep an alpha channel and opaque ones
+// stay opaque so their textures do not pick up blending.
+SDL_Surface* DecodeImage(const std::string& path, Uint32 format) {
+    SDL_Surface* surface = IMG_Load_RW(Assets::OpenFile(path), 1);
+    if (!surface) {
+        return nullptr;
+    }
+    if (format == 0) {
+        const bool has_alpha = SDL_ISPIXELFORMAT_ALPHA(surface->format->format) || SDL_HasColorKey(surface);
+        format = has_alpha ? SDL_PIXELFORMAT_ARGB8888 : SDL_PIXELFORMAT_RGB888;
+    }
+    if (surface->format->format == format) {
+        return surface;
+    }
+    SDL_Surface* converted = SDL_ConvertSurfaceFormat(surface, format, 0);
+    SDL_FreeSurface(surface);
+    return converted;
+}
+
+void FreeResult(SDL_Surface* surface, Mix_Chunk* chunk) {
+    if (surface) {
+        SDL_FreeSurface(surface);
+    }
+    if (chunk) {
+        Mix_FreeChunk(chunk);
+    }
+}
+}  // namespace
+
+AssetLoader::~AssetLoader() {
+    Cancel();
+}
+
+void AssetLoader::Start(Assets* assets, const std::string& atlas_index_path, int worker_count) {
+    Cancel();
+    assets_ = assets;
+    start_counter_ = SDL_GetPerformanceCounter();
+    assets->LoadPrescaled(kPrescaledIndexPath);
+
+    // Only the preload set is decoded here; everything else becomes resident
+    // on first use. Atlas pages holding part of the set decode like any other
+    // image, the rest stay registered for later, and the packed textures are
+    // aliased once the needed pages are uploaded.
+    std::unordered_map<std::string, int> packed;
+    const bool has_atlas = assets->AtlasEnabled() && Assets::ReadAtlasIndex(atlas_index_path, &atlas_);
+    if (has_atlas) {
+        for (const AtlasIndex::Sprite& sprite : atlas_.sprites) {
+            packed[sprite.name] = sprite.page;
+        }
+    }
+    std::vector<bool> needed_pages(atlas_.pages.size(), false);
+    for (TextureId id : Assets::PreloadTextures()) {
+        auto it = packed.find(Assets::AtlasSpriteName(id));
+        if (it != packed.end() && !assets->IsPrescaled(id)) {
+            atlas_textures_.push_back(id);
+            needed_pages[it->second] = true;
+        } else {
+            jobs_.push_back(
+                Job{JobKind::kTexture, static_cast<int>(id), assets->TextureFilePath(id), assets->TextureFileFormat(id)});
+        }
+    }
+    if (has_atlas) {
+        atlas_pages_.assign(atlas_.pages.size(), nullptr);
+        for (size_t i = 0; i < atlas_.pages.size(); ++i) {
+            if (needed_pages[i]) {
+                jobs_.push_back(Job{JobKind::kAtlasPage, static_cast<int>(i), atlas_.pages[i], 0});
+                atlas_pages_pending_++;
+            }
+        }
+        if (atlas_pages_pending_ == 0) {
+            InstallAtlas();
+        }
+    }
+    if (assets->AudioEnabled()) {
+        // Binding the bank is only a map, so it happens right here; workers
+        // decode whatever it does not cover.
+        assets->LoadSoundBank(kSoundBankPath);
+        for (int i = 0; i < kSoundCount; ++i) {
+            const SoundId id = static_cast<SoundId>(i);
+            if (!assets->GetSound(id)) {
+                jobs_.push_back(Job{JobKind::kSound, i, SoundPath(id), 0});
+            }
+        }
+    }
+    total_ = static_cast<int>(jobs_.size()) + kFontCount + kSkeletonCount;
+
+    if (worker_count <= 0) {
+        const int cores = static_cast<int>(std::thread::hardware_concurrency());
+        worker_count = std::clamp(cores - 1, 1, kMaxWorkers);
+    }
+    worker_count_ = std::min(worker_count, static_cast<int>(jobs_.size()));
+    // jobs_ is fixed from here on; workers only read it.
+    for (int i = 0; i < worker_count_; ++i) {
+        workers_.emplace_back(&AssetLoader::WorkerMain, this);
+    }
+}
+
+void AssetLoader::WorkerMain() {
+    while (!cancel_.load(std::memory_order_relaxed)) {
+        const int index = next_job_.fetch_add(1);
+        if (index >= static_cast<int>(jobs_.size())) {
+            return;
+        }
+        const Job& job = jobs_[index];
+        Result result{&job, nullptr, nullptr};
+        if (job.kind == JobKind::kSound) {
+            result.chunk = Mix_LoadWAV_RW(Assets::OpenFile(job.path), 1);
+        } else {
+            result.surface = DecodeImage(job.path, job.format);
+        }
+        if (!result.surface && !result.chunk) {
+            SDL_Log("could not load %s: %s", job.path.c_str(), SDL_GetError());
+        }
+        std::lock_guard<std::mutex> lock(results_mutex_);
+        results_.push_back(result);
+    }
+}
+
+void AssetLoader::Pump(double budget_ms) {
+    if (done_ || !assets_) {
+        return;
+    }
+    const Uint64 frequency = SDL_GetPerformanceFrequency();
+    const Uint64 deadline =
+        SDL_GetPerformanceCounter() + static_cast<Uint64>(budget_ms * static_cast<double>(frequency) / 1000.0);
+    bool uploaded = false;
+    while (true) {
+        if (pending_next_ == pending_.size()) {
+            pending_.clear();
+            pending_next_ = 0;
+            std::lock_guard<std::mutex> lock(results_mutex_);
+            pending_.swap(results_);
+        }
+        if (pending_.empty() || (uploaded && SDL_GetPerformanceCounter() >= deadline)) {
+            break;
+        }
+        Upload(pending_[pending_next_++]);
+        uploaded = true;
+    }
+    if (handled_jobs_ == static_cast<int>(jobs_.size())) {
+        Finish();
+    }
+}
+
+void AssetLoader::Upload(const Result& result) {
+    const Job& job = *result.job;
+    handled_jobs_++;
+    completed_++;
+    if (!result.surface && !result.chunk) {
+        failed_++;
+    }
+    switch (job.kind) {
+    case JobKind::kAtlasPage:
+        if (result.surface) {
+            atlas_pages_[job.index] = assets_->UploadSurface(result.surface);
+        }
+        if (--atlas_pages_pending_ == 0) {
+            InstallAtlas();
+        }
+        break;
+    case JobKind::kTexture:
+        if (result.surface) {
+            const int width = result.surface->w;
+            const int height = result.surface->h;
+            assets_->SetTexture(static_cast<TextureId>(job.index), assets_->UploadSurface(result.surface), width,
+                                height);
+        }
+        break;
+    case JobKind::kSound:
+        if (result.chunk) {
+            assets_->SetSound(static_cast<SoundId>(job.index), result.chunk);
+        }
+        break;
+    }
+}
+
+void AssetLoader::InstallAtlas() {
+    assets_->InstallAtlas(atlas_, atlas_pages_);
+    for (TextureId id : atlas_textures_) {
+        // A page that failed to load leaves its sprites to the loose PNGs.
+        if (!assets_->AliasAtlasTexture(id) && !assets_->LoadTexture(id)) {
+            failed_++;
+        }
+    }
+}
+
+void AssetLoader::Finish() {
+    StopWorkers();
+    for (int i = 0; i < kFontCount; ++i) {
+        failed_ += assets_->LoadFont(static_cast<FontId>(i)) ? 0 : 1;
+        completed_++;
+    }
+    for (int i = 0; i < kSkeletonCount; ++i) {
+        failed_ += assets_->LoadSkeleton(static_cast<SkeletonId>(i)) ? 0 : 1;
+        completed_++;
+    }
+    done_ = true;
+
+    const double elapsed_ms = static_cast<double>(SDL_GetPerformanceCounter() - start_counter_) * 1000.0 /
+                              static_cast<double>(SDL_GetPerformanceFrequency());
+    SDL_Log("preload: %d assets in %.1f ms on %d worker(s), %d failed", total_, elapsed_ms, worker_count_, failed_);
+}
+
+void AssetLoader::Cancel() {
+    cancel_ = true;
+    StopWorkers();
+    for (const Result& result : results_) {
+        FreeResult(result.surface, result.chunk);
+    }
+    for (size_t i = pending_next_; i < pending_.size(); ++i) {
+        FreeResult(pending_[i].surface, pending_[i].chunk);
+    }
+    results_.clear();
+    pending_.clear();
+    pending_next_ = 0;
+
+    assets_ = nullptr;
+    atlas_ = AtlasIndex{};
+    atlas_pages_.clear();
+    atlas_pages_pending_ = 0;
+    atlas_textures_.clear();
+    jobs_.clear();
+    next_job_ = 0;
+    worker_count_ = 0;
+    cancel_ = false;
+    handled_jobs_ = 0;
+    completed_ = 0;
+    total_ = 0;
+    failed_ = 0;
+    done_ = false;
+}
+
+void AssetLoader::StopWorkers() {
+    for (std::thread& worker : workers_) {
+        worker.join();
+    }
+    workers_.clear();
+}
+
+float AssetLoader::Progress() const {
+    if (done_) {
+        return 1.0f;
+    }
+    return total_ > 0 ? static_cast<float>(completed_) / static_cast<float>(total_) : 0.0f;
+}
+
+bool AssetLoader::LoadAll(Assets& assets, const std::string& atlas_index_path) {
+    // Optional: produced by pack_assets.sh. Missing atlas falls back to loose
+    // PNGs, missing prescaled copies to the design-size ones.
+    assets.LoadPrescaled(kPrescaledIndexPath);
+    assets.LoadAtlas(atlas_index_path);
+
+    bool ok = true;
+    for (TextureId id : Assets::PreloadTextures()) {
+        ok &= assets.LoadTexture(id);
+    }
+    for (int i = 0; i < kFontCount; ++i) {
+        ok &= assets.LoadFont(static_cast<FontId>(i));
+    }
+    assets.LoadSoundBank(kSoundBankPath);
+    for (int i = 0; i < kSoundCount; ++i) {
+        const SoundId id = static_cast<SoundId>(i);
+        if (!assets.GetSound(id)) {
+            ok &= assets.LoadSound(id);
+        }
+    }
+    for (int i = 0; i < kSkeletonCount; ++i) {
+        ok &= assets.LoadSkeleton(static_cast<SkeletonId>(i));
+    }
+    return ok;
+}
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_mixer.h>
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Assets.h"
+
+// Loads everything PreloadState needs without blocking the render thread.
+// Worker threads decode the atlas pages and loose PNGs of the preload set
+// (Assets::PreloadTextures) into surfaces, already converted to the upload
+// format, and any OGG the pre-decoded sound bank does not cover into mixer
+// chunks. The render thread calls Pump once per frame to upload finished
+// surfaces until its time budget runs out. Fonts and skeletons are cheap and
+// load on the render thread once their textures are in place. Textures
+// outside the preload set become resident on first use.
+class AssetLoader {
+public:
+    AssetLoader() = default;
+    ~AssetLoader();
+
+    AssetLoader(const AssetLoader&) = delete;
+    AssetLoader& operator=(const AssetLoader&) = delete;
+
+    // `worker_count` <= 0 picks one worker per core, leaving one core for the
+    // render thread.
+    void Start(Assets* assets, const std::string& atlas_index_path, int worker_count = 0);
+    // Uploads decoded results for up to `budget_ms` (at least one per call)
+    // and finishes the main-thread steps once everything has arrived.
+    void Pump(double budget_ms);
+    // Stops the workers and frees anything decoded but not yet handed over.
+    void Cancel();
+
+    bool Done() const { return done_; }
+    // 0..1, counting every texture, sound, font and skeleton.
+    float Progress() const;
+    int FailedCount() const { return failed_; }
+    int WorkerCount() const { return worker_count_; }
+
+    // Loads the same set synchronously on the calling thread. Used when there
+    // is no frame loop to spread the work over (headless runs, benchmarks).
+    static bool LoadAll(Assets& assets, const std::string& atlas_index_path);
+
+private:
+    enum class JobKind { kAtlasPage, kTexture, kSound };
+
+    struct Job {
+        JobKind kind;
+        int index;  // atlas page, TextureId or SoundId
+        std::string path;
+        Uint32 format;  // textures: Assets::TextureFileFormat
+    };
+
+    struct Result {
+        const Job* job;
+        SDL_Surface* surface;
+        Mix_Chunk* chunk;
+    };
+
+    Assets* assets_ = nullptr;
+    AtlasIndex atlas_;
+    std::vector<SDL_Texture*> atlas_pages_;
+    int atlas_pages_pending_ = 0;
+    std::vector<TextureId> atlas_textures_;
+
+    std::vector<Job> jobs_;
+    std::atomic<int> next_job_{0};
+    std::atomic<bool> cancel_{false};
+    std::vector<std::thread> workers_;
+    int worker_count_ = 0;
+
+    std::mutex results_mutex_;
+    std::vector<Result> results_;  // guarded by results_mutex_
+    std::vector<Result> pending_;  // render thread's side of the swap
+    size_t pending_next_ = 0;
+
+    Uint64 start_counter_ = 0;
+    int handled_jobs_ = 0;
+    int completed_ = 0;
+    int total_ = 0;
+    int failed_ = 0;
+    bool done_ = false;
+
+    void WorkerMain();
+    void Upload(const Result& result);
+    void InstallAtlas();
+    void Finish();
+    void StopWorkers();
+};
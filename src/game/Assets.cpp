@@ -1,111 +1,641 @@
 #include "Assets.h"
 
 #include <SDL2/SDL_image.h>
+#include <cstdio>
+#include <cstring>
+#include <sstream>
 
-bool Assets::Init(SDL_Renderer* renderer) {
+#include "SoundBankFormat.h"
+
+namespace {
+std::string FileStem(const std::string& path) {
+    const size_t slash = path.find_last_of("/\\");
+    const size_t start = (slash == std::string::npos) ? 0 : slash + 1;
+    const size_t dot = path.find_last_of('.');
+    const size_t end = (dot == std::string::npos || dot < start) ? path.size() : dot;
+    return path.substr(start, end - start);
+}
+
+std::string DirectoryOf(const std::string& path) {
+    const size_t slash = path.find_last_of("/\\");
+    if (slash == std::string::npos) {
+        return ".";
+    }
+    return path.substr(0, slash);
+}
+
+// The prefetch sets. pack_assets.sh packs each set (and the font pages) on
+// atlas pages of its own, so holding one set never pins another's sprites;
+// keep its group lists in step with these.
+struct TextureRange {
+    TextureId first;
+    int count;
+};
+
+constexpr TextureRange kMenuTextures[] = {
+    {TextureId::kBg, 1},
+    {TextureId::kLand0, 6},
+    {TextureId::kShadow, 1},
+    {TextureId::kStickman, 1},
+    {TextureId::kTitle, 1},
+    {TextureId::kTouchToPlay, 1},
+    {TextureId::kColon, 1},
+    {TextureId::kDot, 1},
+    {TextureId::kWordBest, 1},
+    {TextureId::kButtonGamecenter0, 2},
+    {TextureId::kButtonShare0, 2},
+};
+
+// Also covers ResultState.
+constexpr TextureRange kGameplayTextures[] = {
+    {TextureId::kBg, 1},
+    {TextureId::kLand0, 6},
+    {TextureId::kLandWhite, 1},
+    {TextureId::kBall0, 5},
+    {TextureId::kShadow, 1},
+    {TextureId::kNumberItem1, 4},
+    {TextureId::kStickman, 1},
+    {TextureId::kGauge, 1},
+    {TextureId::kGaugeHead, 1},
+    {TextureId::kWhite4, 1},
+    {TextureId::kEffectHit, 1},
+    {TextureId::kDot, 1},
+    {TextureId::kWordBest, 1},
+    {TextureId::kWordYour, 1},
+    {TextureId::kButtonGamecenter0, 2},
+    {TextureId::kButtonShare0, 2},
+    {TextureId::kButtonPlay0, 2},
+};
+
+constexpr TextureRange kDeathTextures[] = {
+    {TextureId::kBlood, 1},
+    {TextureId::kDeadParts0, 8},
+    {TextureId::kEffectBlood0, 11},
+};
+
+template <size_t N>
+void AppendRanges(const TextureRange (&ranges)[N], std::vector<TextureId>* out_ids) {
+    for (const TextureRange& range : ranges) {
+        for (int i = 0; i < range.count; ++i) {
+            out_ids->push_back(TextureFrame(range.first, i));
+        }
+    }
+}
+
+void SetTextures(TextureSet set, std::vector<TextureId>* out_ids) {
+    switch (set) {
+    case TextureSet::kMenu:
+        AppendRanges(kMenuTextures, out_ids);
+        break;
+    case TextureSet::kGameplay:
+        AppendRanges(kGameplayTextures, out_ids);
+        break;
+    case TextureSet::kDeath:
+        AppendRanges(kDeathTextures, out_ids);
+        break;
+    }
+}
+}
+
+Assets::Assets() {
+    ResetTextureSources();
+}
+
+bool Assets::Init(SDL_Renderer* renderer, bool audio_enabled) {
     renderer_ = renderer;
+    audio_enabled_ = audio_enabled;
+    voices_.Init(audio_enabled);
+    ResetTextureSources();
+    rgb565_supported_ = false;
+    SDL_RendererInfo info;
+    if (renderer_ && SDL_GetRendererInfo(renderer_, &info) == 0) {
+        for (Uint32 i = 0; i < info.num_texture_formats; ++i) {
+            rgb565_supported_ |= info.texture_formats[i] == SDL_PIXELFORMAT_RGB565;
+        }
+    }
     return true;
 }
 
+void Assets::BeginFrame() {
+    // Settles an over-budget frame once it is done: anything the last frame
+    // did not draw can go.
+    EnforceBudget();
+    frame_clock_++;
+    voices_.BeginFrame();
+}
+
 void Assets::Shutdown() {
+    FreeSkeletons();
     FreeFonts();
+    voices_.Shutdown();
     FreeSounds();
+    sound_bank_.Close();
     FreeTextures();
+    UnmountArchive();
     renderer_ = nullptr;
 }
 
-bool Assets::LoadTexture(const std::string& key, const std::string& path) {
-    if (!renderer_) {
+SDL_RWops* Assets::OpenFile(const std::string& path) {
+    const unsigned char* data = nullptr;
+    std::size_t size = 0;
+    const AssetArchive* archive = MountedAssetArchive();
+    if (archive && archive->Find(path, &data, &size)) {
+        return SDL_RWFromConstMem(data, static_cast<int>(size));
+    }
+    return SDL_RWFromFile(path.c_str(), "rb");
+}
+
+bool Assets::MountArchive(const std::string& path) {
+    UnmountArchive();
+    if (!archive_.Open(path)) {
         return false;
     }
-    SDL_Surface* surface = IMG_Load(path.c_str());
+    MountAssetArchive(&archive_);
+    SDL_Log("mounted %s (%d files)", path.c_str(), archive_.EntryCount());
+    return true;
+}
+
+void Assets::UnmountArchive() {
+    if (MountedAssetArchive() == &archive_) {
+        MountAssetArchive(nullptr);
+    }
+    archive_.Close();
+}
+
+SDL_Texture* Assets::LoadTextureFile(const std::string& path, Uint32 format, int* out_width, int* out_height) const {
+    SDL_Surface* surface = IMG_Load_RW(OpenFile(path), 1);
     if (!surface) {
-        return false;
+        return nullptr;
+    }
+    if (format != 0 && surface->format->format != format) {
+        // SDL_CreateTextureFromSurface keeps the surface's format when the
+        // renderer supports it.
+        SDL_Surface* converted = SDL_ConvertSurfaceFormat(surface, format, 0);
+        SDL_FreeSurface(surface);
+        if (!converted) {
+            return nullptr;
+        }
+        surface = converted;
     }
+    *out_width = surface->w;
+    *out_height = surface->h;
+    return UploadSurface(surface);
+}
+
+SDL_Texture* Assets::UploadSurface(SDL_Surface* surface) const {
     SDL_Texture* texture = SDL_CreateTextureFromSurface(renderer_, surface);
-    TextureAsset asset;
-    asset.texture = texture;
-    asset.width = surface->w;
-    asset.height = surface->h;
     SDL_FreeSurface(surface);
-    if (!texture) {
+    return texture;
+}
+
+bool Assets::ReadAtlasIndex(const std::string& index_path, AtlasIndex* out_index) {
+    AssetFile index_file;
+    if (!index_file.Open(index_path)) {
+        return false;
+    }
+    std::istringstream file(std::string(reinterpret_cast<const char*>(index_file.Data()), index_file.Size()));
+
+    const std::string directory = DirectoryOf(index_path);
+    out_index->pages.clear();
+    out_index->sprites.clear();
+    std::string line;
+    char name[256];
+    while (std::getline(file, line)) {
+        if (std::sscanf(line.c_str(), "page %255s", name) == 1) {
+            out_index->pages.push_back(directory + "/" + name);
+            continue;
+        }
+        AtlasIndex::Sprite sprite;
+        if (std::sscanf(line.c_str(), "sprite %255s %d %d %d %d %d", name, &sprite.page, &sprite.src.x, &sprite.src.y,
+                        &sprite.src.w, &sprite.src.h) != 6) {
+            continue;
+        }
+        if (sprite.page < 0 || static_cast<size_t>(sprite.page) >= out_index->pages.size()) {
+            continue;
+        }
+        sprite.name = name;
+        out_index->sprites.push_back(sprite);
+    }
+    return !out_index->pages.empty();
+}
+
+std::string Assets::AtlasSpriteName(TextureId id) {
+    return FileStem(TexturePath(id));
+}
+
+bool Assets::LoadAtlas(const std::string& index_path) {
+    if (!renderer_ || !atlas_enabled_) {
+        return false;
+    }
+    AtlasIndex index;
+    if (!ReadAtlasIndex(index_path, &index)) {
         return false;
     }
-    textures_[key] = asset;
+    InstallAtlas(index, std::vector<SDL_Texture*>(index.pages.size(), nullptr));
     return true;
 }
 
-TextureAsset Assets::GetTexture(const std::string& key) const {
-    auto it = textures_.find(key);
-    if (it == textures_.end()) {
-        return {};
+void Assets::InstallAtlas(const AtlasIndex& index, const std::vector<SDL_Texture*>& pages) {
+    const int first_page = static_cast<int>(sources_.size());
+    for (size_t i = 0; i < index.pages.size(); ++i) {
+        sources_.push_back(TextureSource{});
+        sources_.back().path = index.pages[i];
+        SDL_Texture* page = i < pages.size() ? pages[i] : nullptr;
+        int width = 0;
+        int height = 0;
+        if (page && SDL_QueryTexture(page, nullptr, nullptr, &width, &height) == 0) {
+            InstallSource(first_page + static_cast<int>(i), page, width, height);
+        } else if (page) {
+            SDL_DestroyTexture(page);
+        }
+    }
+    for (const AtlasIndex::Sprite& sprite : index.sprites) {
+        atlas_sprites_[sprite.name] = AtlasSprite{first_page + sprite.page, sprite.src};
+    }
+}
+
+bool Assets::LoadPrescaled(const std::string& index_path) {
+    if (!prescaled_enabled_) {
+        return false;
+    }
+    AssetFile index_file;
+    if (!index_file.Open(index_path)) {
+        return false;
+    }
+    std::istringstream file(std::string(reinterpret_cast<const char*>(index_file.Data()), index_file.Size()));
+
+    const std::string directory = DirectoryOf(index_path);
+    std::string line;
+    char name[256];
+    char path[256];
+    char format[32];
+    int width = 0;
+    int height = 0;
+    bool any = false;
+    while (std::getline(file, line)) {
+        if (std::sscanf(line.c_str(), "texture %255s %255s %d %d %31s", name, path, &width, &height, format) != 5 ||
+            width <= 0 || height <= 0) {
+            continue;
+        }
+        for (int i = 0; i < kTextureCount; ++i) {
+            if (AtlasSpriteName(static_cast<TextureId>(i)) != name) {
+                continue;
+            }
+            Evict(i);
+            TextureSource& source = sources_[i];
+            source.path = directory + "/" + path;
+            source.failed = false;
+            const bool rgb565 = std::strcmp(format, "rgb565") == 0 && rgb565_supported_;
+            source.format = rgb565 ? static_cast<Uint32>(SDL_PIXELFORMAT_RGB565) : 0;
+            source.design_width = width;
+            source.design_height = height;
+            texture_sources_[i] = -1;
+            any = true;
+        }
     }
-    return it->second;
+    return any;
 }
 
-bool Assets::LoadFont(const std::string& key, const std::string& image_path, const std::string& xml_path) {
-    BitmapFont font;
-    if (!font.Load(renderer_, image_path, xml_path)) {
+bool Assets::AliasAtlasTexture(TextureId id) {
+    if (!atlas_enabled_ || IsPrescaled(id)) {
+        return false;
+    }
+    auto it = atlas_sprites_.find(AtlasSpriteName(id));
+    if (it == atlas_sprites_.end() || sources_[it->second.source].failed) {
         return false;
     }
-    fonts_[key] = std::move(font);
+    const int index = static_cast<int>(id);
+    TextureAsset& asset = textures_[index];
+    asset.texture = sources_[it->second.source].texture;
+    asset.src = it->second.src;
+    asset.width = it->second.src.w;
+    asset.height = it->second.src.h;
+    texture_sources_[index] = it->second.source;
     return true;
 }
 
-const BitmapFont* Assets::GetFont(const std::string& key) const {
-    auto it = fonts_.find(key);
-    if (it == fonts_.end()) {
-        return nullptr;
+void Assets::SetTexture(TextureId id, SDL_Texture* texture, int width, int height) {
+    const int index = static_cast<int>(id);
+    Evict(index);
+    texture_sources_[index] = index;
+    sources_[index].failed = false;
+    InstallSource(index, texture, width, height);
+    textures_[index].texture = texture;
+}
+
+bool Assets::LoadTexture(TextureId id) {
+    if (!renderer_) {
+        return false;
     }
-    return &it->second;
+    return GetTexture(id).texture != nullptr;
 }
 
-bool Assets::LoadSound(const std::string& key, const std::string& path) {
-    Mix_Chunk* chunk = Mix_LoadWAV(path.c_str());
-    if (!chunk) {
+const TextureAsset& Assets::GetTexture(TextureId id) const {
+    const int index = static_cast<int>(id);
+    TextureAsset& asset = textures_[index];
+    int source = ResolveTexture(id);
+    if (!MakeResident(source) && source != index) {
+        // A page that failed to load leaves its sprites to the loose PNGs.
+        // Whether or not the PNG was already resident, the page's sub-rect no
+        // longer applies.
+        texture_sources_[index] = source = index;
+        if (MakeResident(source)) {
+            int width = 0;
+            int height = 0;
+            SDL_QueryTexture(sources_[source].texture, nullptr, nullptr, &width, &height);
+            SetLooseRect(index, width, height);
+        }
+    }
+    asset.texture = sources_[source].texture;
+    return asset;
+}
+
+void Assets::Prefetch(TextureSet set) {
+    std::vector<TextureId> ids;
+    SetTextures(set, &ids);
+    for (TextureId id : ids) {
+        GetTexture(id);
+        sources_[texture_sources_[static_cast<int>(id)]].holds++;
+    }
+}
+
+void Assets::Release(TextureSet set) {
+    std::vector<TextureId> ids;
+    SetTextures(set, &ids);
+    for (TextureId id : ids) {
+        const int source = texture_sources_[static_cast<int>(id)];
+        if (source >= 0 && sources_[source].holds > 0) {
+            sources_[source].holds--;
+        }
+    }
+}
+
+std::vector<TextureId> Assets::PreloadTextures() {
+    std::vector<TextureId> ids;
+    for (int i = 0; i < kFontCount; ++i) {
+        ids.push_back(FontTexture(static_cast<FontId>(i)));
+    }
+    SetTextures(TextureSet::kMenu, &ids);
+    return ids;
+}
+
+int Assets::ResidentTextureCount() const {
+    int count = 0;
+    for (const TextureSource& source : sources_) {
+        count += source.texture ? 1 : 0;
+    }
+    return count;
+}
+
+void Assets::ResetTextureSources() {
+    sources_.assign(kTextureCount, TextureSource{});
+    for (int i = 0; i < kTextureCount; ++i) {
+        sources_[i].path = TexturePath(static_cast<TextureId>(i));
+    }
+    texture_sources_.fill(-1);
+    textures_.fill(TextureAsset{});
+    atlas_sprites_.clear();
+    resident_bytes_ = 0;
+    evictions_ = 0;
+    warned_over_budget_ = false;
+}
+
+int Assets::ResolveTexture(TextureId id) const {
+    const int index = static_cast<int>(id);
+    int& source = texture_sources_[index];
+    if (source >= 0) {
+        return source;
+    }
+    source = index;
+    if (atlas_enabled_ && !IsPrescaled(id)) {
+        auto it = atlas_sprites_.find(AtlasSpriteName(id));
+        if (it != atlas_sprites_.end() && !sources_[it->second.source].failed) {
+            TextureAsset& asset = textures_[index];
+            asset.src = it->second.src;
+            asset.width = it->second.src.w;
+            asset.height = it->second.src.h;
+            source = it->second.source;
+        }
+    }
+    return source;
+}
+
+bool Assets::MakeResident(int index) const {
+    TextureSource& source = sources_[index];
+    source.last_used = frame_clock_;
+    if (source.texture) {
+        return true;
+    }
+    if (source.failed || !renderer_) {
+        return false;
+    }
+    int width = 0;
+    int height = 0;
+    SDL_Texture* texture = LoadTextureFile(source.path, source.format, &width, &height);
+    if (!texture && source.design_width > 0) {
+        // A broken prescaled copy leaves the texture to its full-size PNG.
+        SDL_Log("could not load %s: %s", source.path.c_str(), SDL_GetError());
+        source.path = TexturePath(static_cast<TextureId>(index));
+        source.format = 0;
+        source.design_width = 0;
+        source.design_height = 0;
+        texture = LoadTextureFile(source.path, source.format, &width, &height);
+    }
+    if (!texture) {
+        SDL_Log("could not load %s: %s", source.path.c_str(), SDL_GetError());
+        source.failed = true;
         return false;
     }
-    sounds_[key] = chunk;
+    InstallSource(index, texture, width, height);
     return true;
 }
 
-Mix_Chunk* Assets::GetSound(const std::string& key) const {
-    auto it = sounds_.find(key);
-    if (it == sounds_.end()) {
-        return nullptr;
+void Assets::InstallSource(int index, SDL_Texture* texture, int width, int height) const {
+    TextureSource& source = sources_[index];
+    Uint32 format = SDL_PIXELFORMAT_UNKNOWN;
+    SDL_QueryTexture(texture, &format, nullptr, nullptr, nullptr);
+    const size_t bytes_per_pixel = format != SDL_PIXELFORMAT_UNKNOWN ? SDL_BYTESPERPIXEL(format) : 4;
+    source.texture = texture;
+    source.bytes = static_cast<size_t>(width) * static_cast<size_t>(height) * bytes_per_pixel;
+    source.last_used = frame_clock_;
+    resident_bytes_ += source.bytes;
+    if (index < kTextureCount) {
+        SetLooseRect(index, width, height);
     }
-    return it->second;
+    EnforceBudget();
 }
 
-void Assets::PlaySound(const std::string& key, int volume) {
-    Mix_Chunk* chunk = GetSound(key);
-    if (!chunk) {
+void Assets::SetLooseRect(int index, int width, int height) const {
+    const TextureSource& source = sources_[index];
+    TextureAsset& asset = textures_[index];
+    asset.src = SDL_Rect{0, 0, width, height};
+    asset.width = source.design_width > 0 ? source.design_width : width;
+    asset.height = source.design_height > 0 ? source.design_height : height;
+}
+
+void Assets::Evict(int index) const {
+    TextureSource& source = sources_[index];
+    if (!source.texture) {
         return;
     }
-    Mix_VolumeChunk(chunk, volume);
-    Mix_PlayChannel(-1, chunk, 0);
+    SDL_DestroyTexture(source.texture);
+    source.texture = nullptr;
+    resident_bytes_ -= source.bytes;
+    source.bytes = 0;
+    evictions_++;
+}
+
+void Assets::EnforceBudget() const {
+    while (texture_budget_ > 0 && resident_bytes_ > texture_budget_) {
+        int victim = -1;
+        for (int i = 0; i < static_cast<int>(sources_.size()); ++i) {
+            const TextureSource& source = sources_[i];
+            if (!source.texture || source.holds > 0 || source.last_used == frame_clock_) {
+                continue;
+            }
+            if (victim < 0 || source.last_used < sources_[victim].last_used) {
+                victim = i;
+            }
+        }
+        if (victim < 0) {
+            if (!warned_over_budget_) {
+                SDL_Log("texture budget %zu KB exceeded by held and in-use textures (%zu KB resident)",
+                        texture_budget_ / 1024, resident_bytes_ / 1024);
+                warned_over_budget_ = true;
+            }
+            return;
+        }
+        Evict(victim);
+    }
+}
+
+bool Assets::LoadFont(FontId id) {
+    const TextureId texture = FontTexture(id);
+    if (!LoadTexture(texture)) {
+        return false;
+    }
+    // The font keeps the raw SDL_Texture, so its page must never be evicted.
+    // Packed, font pages hold nothing else.
+    sources_[texture_sources_[static_cast<int>(texture)]].holds++;
+    const FontPaths& paths = FontSource(id);
+    BitmapFont& font = fonts_[static_cast<int>(id)];
+    return font.Load(GetTexture(texture), paths.compiled) || font.Load(GetTexture(texture), paths.xml);
+}
+
+const BitmapFont* Assets::GetFont(FontId id) const {
+    const BitmapFont& font = fonts_[static_cast<int>(id)];
+    return font.IsLoaded() ? &font : nullptr;
+}
+
+bool Assets::LoadSoundBank(const std::string& path) {
+    if (!audio_enabled_) {
+        return false;
+    }
+    if (sound_bank_.IsOpen()) {
+        // Chunks bound to the old mapping must go before it is unmapped.
+        FreeSounds();
+        sound_bank_.Close();
+    }
+    SoundBankView bank;
+    if (!sound_bank_.Open(path) || !BindSoundBank(sound_bank_.Data(), sound_bank_.Size(), &bank)) {
+        sound_bank_.Close();
+        return false;
+    }
+    int frequency = 0;
+    Uint16 format = 0;
+    int channels = 0;
+    if (Mix_QuerySpec(&frequency, &format, &channels) == 0 || bank.header->frequency != static_cast<Uint32>(frequency) ||
+        bank.header->format != format || bank.header->channels != static_cast<Uint32>(channels)) {
+        SDL_Log("sound bank %s does not match the mixer (%d Hz, format 0x%x, %d channels); decoding OGGs", path.c_str(),
+                frequency, format, channels);
+        sound_bank_.Close();
+        return false;
+    }
+
+    for (int i = 0; i < kSoundCount; ++i) {
+        const SoundId id = static_cast<SoundId>(i);
+        const int index = bank.FindSound(SoundPath(id));
+        if (index < 0) {
+            continue;
+        }
+        // The mixer only reads the buffer, and Mix_FreeChunk leaves memory it
+        // did not allocate alone, so the chunk can point into the read-only map.
+        Uint8* pcm = const_cast<Uint8*>(bank.Data(index));
+        Mix_Chunk* chunk = Mix_QuickLoad_RAW(pcm, bank.sounds[index].data_bytes);
+        if (chunk) {
+            SetSound(id, chunk);
+        }
+    }
+    return true;
+}
+
+bool Assets::LoadSound(SoundId id) {
+    if (!audio_enabled_) {
+        return true;
+    }
+    Mix_Chunk* chunk = Mix_LoadWAV_RW(OpenFile(SoundPath(id)), 1);
+    if (!chunk) {
+        return false;
+    }
+    SetSound(id, chunk);
+    return true;
+}
+
+void Assets::SetSound(SoundId id, Mix_Chunk* chunk) {
+    Mix_Chunk*& slot = sounds_[static_cast<int>(id)];
+    if (slot) {
+        Mix_FreeChunk(slot);
+    }
+    slot = chunk;
+}
+
+void Assets::PlaySound(SoundId id, int volume) {
+    voices_.Play(id, GetSound(id), volume);
+}
+
+bool Assets::LoadSkeleton(SkeletonId id) {
+    const SkeletonPaths& paths = SkeletonSource(id);
+    SkeletonData& skeleton = skeletons_[static_cast<int>(id)];
+    if (!skeleton.Load(paths.compiled, paths.json, paths.atlas)) {
+        return false;
+    }
+    if (skeleton_bake_hz_ > 0) {
+        skeleton.Bake(static_cast<float>(skeleton_bake_hz_), skeleton_bake_lerp_);
+    }
+    return true;
+}
+
+const SkeletonData* Assets::GetSkeleton(SkeletonId id) const {
+    const SkeletonData& skeleton = skeletons_[static_cast<int>(id)];
+    return skeleton.IsLoaded() ? &skeleton : nullptr;
 }
 
 void Assets::FreeTextures() {
-    for (auto& entry : textures_) {
-        if (entry.second.texture) {
-            SDL_DestroyTexture(entry.second.texture);
-            entry.second.texture = nullptr;
+    for (TextureSource& source : sources_) {
+        if (source.texture) {
+            SDL_DestroyTexture(source.texture);
         }
     }
-    textures_.clear();
+    ResetTextureSources();
 }
 
 void Assets::FreeFonts() {
-    for (auto& entry : fonts_) {
-        entry.second.Unload();
+    for (auto& font : fonts_) {
+        font.Unload();
     }
-    fonts_.clear();
 }
 
 void Assets::FreeSounds() {
-    for (auto& entry : sounds_) {
-        Mix_FreeChunk(entry.second);
+    for (auto& chunk : sounds_) {
+        if (chunk) {
+            Mix_FreeChunk(chunk);
+            chunk = nullptr;
+        }
+    }
+}
+
+void Assets::FreeSkeletons() {
+    for (auto& skeleton : skeletons_) {
+        skeleton.Unload();
     }
-    sounds_.clear();
 }
@@ -2,39 +2,202 @@
 
 #include <SDL2/SDL.h>
 #include <SDL2/SDL_mixer.h>
+#include <array>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
+#include "AssetIds.h"
 #include "BitmapFont.h"
+#include "AssetArchive.h"
+#include "SkeletonData.h"
+#include "VoiceManager.h"
 
+// A drawable image. When the asset lives in an atlas page, `src` is its
+// sub-rect inside the shared texture; for loose files it covers the whole
+// texture.
 struct TextureAsset {
     SDL_Texture* texture = nullptr;
+    SDL_Rect src{0, 0, 0, 0};
     int width = 0;
     int height = 0;
 };
 
+// A parsed atlas index (tools/AtlasPacker): page image paths and the sprites
+// placed on them.
+struct AtlasIndex {
+    struct Sprite {
+        std::string name;
+        int page = 0;
+        SDL_Rect src{0, 0, 0, 0};
+    };
+    std::vector<std::string> pages;
+    std::vector<Sprite> sprites;
+};
+
+// Texture groups a state makes resident on entry (see Assets::Prefetch).
+enum class TextureSet {
+    kMenu,
+    kGameplay,
+    kDeath  // blood and body parts, drawn only once the hero dies
+};
+
 class Assets {
 public:
-    bool Init(SDL_Renderer* renderer);
+    Assets();
+
+    // With audio disabled sounds "load" as empty slots and PlaySound is a no-op.
+    bool Init(SDL_Renderer* renderer, bool audio_enabled = true);
     void Shutdown();
 
-    bool LoadTexture(const std::string& key, const std::string& path);
-    TextureAsset GetTexture(const std::string& key) const;
+    // Maps an archive written by tools/ArchivePacker. Every later load looks
+    // there first and falls back to the loose file, so a missing archive (or
+    // one without a file) just means reading from assets/.
+    bool MountArchive(const std::string& path);
+    void UnmountArchive();
+    // Opens an asset for the SDL_image / SDL_mixer *_RW loaders: a constant
+    // memory stream into the archive, or the loose file. Null if neither
+    // exists. Safe on worker threads.
+    static SDL_RWops* OpenFile(const std::string& path);
+
+    // Reads an index written by tools/AtlasPacker. Textures whose file stem
+    // matches a packed sprite are then drawn from the shared pages instead of
+    // their own texture; pages load on first use like loose files.
+    bool LoadAtlas(const std::string& index_path);
+    void SetAtlasEnabled(bool enabled) { atlas_enabled_ = enabled; }
+    bool AtlasEnabled() const { return atlas_enabled_; }
+
+    // Reads an index written by tools/TexturePrescaler. Listed textures then
+    // load from their output-resolution copy, in the pixel format the index
+    // names (RGB565 for opaque layers when the renderer has it), while
+    // TextureAsset keeps reporting the design size. They bypass the atlas.
+    bool LoadPrescaled(const std::string& index_path);
+    void SetPrescaledEnabled(bool enabled) { prescaled_enabled_ = enabled; }
+    bool IsPrescaled(TextureId id) const { return sources_[static_cast<int>(id)].design_width > 0; }
 
-    bool LoadFont(const std::string& key, const std::string& image_path, const std::string& xml_path);
-    const BitmapFont* GetFont(const std::string& key) const;
+    // Textures are resident on demand. GetTexture loads a texture the first
+    // time it is asked for (or after it was evicted); the units that load and
+    // evict are loose files and whole atlas pages.
+    bool LoadTexture(TextureId id);
+    const TextureAsset& GetTexture(TextureId id) const;
+    // Loads every texture of `set` now, so a state does not hitch on first
+    // draws mid-animation, and holds it resident until the matching Release.
+    void Prefetch(TextureSet set);
+    void Release(TextureSet set);
+    // What PreloadState loads up front: font pages and the menu set.
+    static std::vector<TextureId> PreloadTextures();
+    // Caps resident texture memory, counted at each texture's bytes per pixel;
+    // 0 means no limit. Over budget, the least recently drawn source that is neither held
+    // (font pages, prefetched sets) nor drawn this frame is destroyed.
+    void SetTextureBudget(size_t bytes) { texture_budget_ = bytes; }
+    size_t ResidentTextureBytes() const { return resident_bytes_; }
+    int ResidentTextureCount() const;
+    int TextureEvictions() const { return evictions_; }
+    // Advances the texture LRU clock and the voice manager's trigger window.
+    void BeginFrame();
 
-    bool LoadSound(const std::string& key, const std::string& path);
-    Mix_Chunk* GetSound(const std::string& key) const;
-    void PlaySound(const std::string& key, int volume = MIX_MAX_VOLUME);
+    bool LoadFont(FontId id);
+    const BitmapFont* GetFont(FontId id) const;
+
+    // Maps the bank and wraps each sound it holds with Mix_QuickLoad_RAW; the
+    // PCM stays in the mapping. False (nothing bound) when the file is missing
+    // or was decoded for a different mixer format.
+    bool LoadSoundBank(const std::string& path);
+    bool LoadSound(SoundId id);
+    Mix_Chunk* GetSound(SoundId id) const { return sounds_[static_cast<int>(id)]; }
+    // Plays through the voice manager (per-sound caps, priorities, one start
+    // per sound per audio frame).
+    void PlaySound(SoundId id, int volume = MIX_MAX_VOLUME);
+
+    // Skeletons loaded after this are baked (see SkeletonData::Bake); 0 keeps
+    // live evaluation.
+    void SetSkeletonBake(int hz, bool lerp) {
+        skeleton_bake_hz_ = hz;
+        skeleton_bake_lerp_ = lerp;
+    }
+    bool LoadSkeleton(SkeletonId id);
+    const SkeletonData* GetSkeleton(SkeletonId id) const;
+
+    // Split loading for AssetLoader: files are decoded elsewhere (worker
+    // threads) and handed in here on the render thread. The synchronous
+    // Load* calls above are built from the same pieces.
+    static bool ReadAtlasIndex(const std::string& index_path, AtlasIndex* out_index);
+    // Name a texture's sprite has in an atlas index.
+    static std::string AtlasSpriteName(TextureId id);
+    // File a texture's own source decodes from and the pixel format to
+    // convert it to (0: ARGB8888, or RGB888 without alpha). Differs from
+    // TexturePath for prescaled textures.
+    const std::string& TextureFilePath(TextureId id) const { return sources_[static_cast<int>(id)].path; }
+    Uint32 TextureFileFormat(TextureId id) const { return sources_[static_cast<int>(id)].format; }
+    // Creates a texture from `surface` and frees the surface. The texture is
+    // owned once handed to InstallAtlas or SetTexture.
+    SDL_Texture* UploadSurface(SDL_Surface* surface) const;
+    // `pages` holds the uploaded page per index entry, or null for a page
+    // that should load on first use.
+    void InstallAtlas(const AtlasIndex& index, const std::vector<SDL_Texture*>& pages);
+    // Points `id` at its atlas sprite; false when the atlas does not have it.
+    bool AliasAtlasTexture(TextureId id);
+    void SetTexture(TextureId id, SDL_Texture* texture, int width, int height);
+    void SetSound(SoundId id, Mix_Chunk* chunk);
+    bool AudioEnabled() const { return audio_enabled_; }
 
 private:
     SDL_Renderer* renderer_ = nullptr;
-    std::unordered_map<std::string, TextureAsset> textures_;
-    std::unordered_map<std::string, BitmapFont> fonts_;
-    std::unordered_map<std::string, Mix_Chunk*> sounds_;
+    bool audio_enabled_ = true;
+    bool atlas_enabled_ = true;
+    bool prescaled_enabled_ = true;
+    bool rgb565_supported_ = false;
+    int skeleton_bake_hz_ = 0;
+    bool skeleton_bake_lerp_ = true;
+    AssetArchive archive_;
+
+    // A loose file or an atlas page: the thing that becomes an SDL_Texture.
+    struct TextureSource {
+        std::string path;
+        SDL_Texture* texture = nullptr;
+        size_t bytes = 0;
+        unsigned int last_used = 0;
+        int holds = 0;  // font pages and prefetched sets; never evicted while > 0
+        bool failed = false;  // not retried every frame
+        Uint32 format = 0;    // see TextureFileFormat
+        // Prescaled files only: the size the texture is laid out and drawn at.
+        int design_width = 0;
+        int design_height = 0;
+    };
+    struct AtlasSprite {
+        int source;
+        SDL_Rect src;
+    };
+    // Sources [0, kTextureCount) are the loose files by TextureId; atlas pages
+    // follow. Render-thread only; mutable so const lookups can load and evict.
+    mutable std::vector<TextureSource> sources_;
+    mutable std::array<int, kTextureCount> texture_sources_{};  // -1 until resolved
+    mutable std::array<TextureAsset, kTextureCount> textures_{};
+    std::unordered_map<std::string, AtlasSprite> atlas_sprites_;
+    size_t texture_budget_ = 0;
+    mutable size_t resident_bytes_ = 0;
+    mutable int evictions_ = 0;
+    mutable bool warned_over_budget_ = false;
+    unsigned int frame_clock_ = 1;
+
+    std::array<BitmapFont, kFontCount> fonts_{};
+    std::array<Mix_Chunk*, kSoundCount> sounds_{};
+    AssetFile sound_bank_;  // backs the chunks bound by LoadSoundBank
+    VoiceManager voices_;
+    std::array<SkeletonData, kSkeletonCount> skeletons_{};
 
     void FreeTextures();
     void FreeSounds();
     void FreeFonts();
+    void FreeSkeletons();
+
+    void ResetTextureSources();
+    int ResolveTexture(TextureId id) const;
+    bool MakeResident(int source) const;
+    void InstallSource(int source, SDL_Texture* texture, int width, int height) const;
+    // Full-texture src and draw size for a loose file, design size if prescaled.
+    void SetLooseRect(int texture, int width, int height) const;
+    void Evict(int source) const;
+    void EnforceBudget() const;
+    SDL_Texture* LoadTextureFile(const std::string& path, Uint32 format, int* out_width, int* out_height) const;
 };
@@ -0,0 +1,95 @@
+#include "BackgroundCache.h"
+
+#include "Assets.h"
+#include "RenderHelpers.h"
+#include "RenderStats.h"
+
+namespace {
+constexpr float kLandY = 800.0f - 204.0f;
+
+bool SameColor(SDL_Color a, SDL_Color b) {
+    return a.r == b.r && a.g == b.g && a.b == b.b && a.a == b.a;
+}
+}
+
+void BackgroundCache::SetEnabled(bool enabled) {
+    enabled_ = enabled;
+    if (!enabled_) {
+        Shutdown();
+    }
+}
+
+void BackgroundCache::Draw(SDL_Renderer* renderer, const RenderContext& ctx, const Assets& assets, TextureId land,
+                           SDL_Color land_tint, int shake_x, int shake_y) {
+    if (!enabled_ || unsupported_ || (!target_ && !CreateTarget(renderer))) {
+        RenderContext shaken = ctx;
+        shaken.offset_x += shake_x;
+        shaken.offset_y += shake_y;
+        Compose(renderer, shaken, assets, land, land_tint);
+        return;
+    }
+
+    if (!valid_ || land != land_ || !SameColor(land_tint, land_tint_)) {
+        SDL_Texture* previous = SDL_GetRenderTarget(renderer);
+        if (SDL_SetRenderTarget(renderer, target_) != 0) {
+            SDL_Log("background cache disabled: %s", SDL_GetError());
+            Shutdown();
+            unsupported_ = true;
+            Draw(renderer, ctx, assets, land, land_tint, shake_x, shake_y);
+            return;
+        }
+        // Cleared to the states' clear colour, so the letterbox bars match.
+        SDL_SetRenderDrawColor(renderer, 255, 255, 255, 255);
+        SDL_RenderClear(renderer);
+        Compose(renderer, ctx, assets, land, land_tint);
+        SDL_SetRenderTarget(renderer, previous);
+        // A layer still loading leaves a hole; keep trying until both drew.
+        valid_ = assets.GetTexture(TextureId::kBg).texture && assets.GetTexture(land).texture;
+        land_ = land;
+        land_tint_ = land_tint;
+        redraws_++;
+    }
+
+    int width = 0;
+    int height = 0;
+    SDL_QueryTexture(target_, nullptr, nullptr, &width, &height);
+    const SDL_Rect dst{shake_x, shake_y, width, height};
+    SDL_RenderCopy(renderer, target_, nullptr, &dst);
+    FrameRenderStats().RecordDraw(target_);
+}
+
+void BackgroundCache::Shutdown() {
+    if (target_) {
+        SDL_DestroyTexture(target_);
+        target_ = nullptr;
+    }
+    valid_ = false;
+    unsupported_ = false;
+}
+
+bool BackgroundCache::CreateTarget(SDL_Renderer* renderer) {
+    int width = 0;
+    int height = 0;
+    if (!SDL_RenderTargetSupported(renderer) || SDL_GetRendererOutputSize(renderer, &width, &height) != 0) {
+        unsupported_ = true;
+        return false;
+    }
+    target_ = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_TARGET, width, height);
+    if (!target_) {
+        SDL_Log("background cache disabled: %s", SDL_GetError());
+        unsupported_ = true;
+        return false;
+    }
+    // The copy covers the whole screen; nothing underneath needs blending.
+    SDL_SetTextureBlendMode(target_, SDL_BLENDMODE_NONE);
+    valid_ = false;
+    return true;
+}
+
+void BackgroundCache::Compose(SDL_Renderer* renderer, const RenderContext& ctx, const Assets& assets, TextureId land,
+                              SDL_Color land_tint) {
+    queue_.SetLayer(RenderLayer::kBackground);
+    DrawTexture(queue_, ctx, assets.GetTexture(TextureId::kBg), 0.0f, 0.0f, 1.0f, 1.0f, SDL_Color{255, 255, 255, 255});
+    DrawTexture(queue_, ctx, assets.GetTexture(land), 0.0f, kLandY, 1.0f, 1.0f, land_tint);
+    queue_.Flush(renderer);
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+
+#include "AssetIds.h"
+#include "RenderContext.h"
+#include "RenderQueue.h"
+
+class Assets;
+
+// The backdrop every state starts its frame with: Bg plus one land strip,
+// optionally tinted. It is composited into a screen-size render target and
+// redrawn only when the strip or its tint changes, so a frame normally costs
+// a single opaque copy instead of two full-screen blended draws. Camera shake
+// moves the copy rather than invalidating it. Renderers without target
+// support, or a cache that is switched off, draw the layers directly.
+class BackgroundCache {
+public:
+    BackgroundCache() = default;
+    ~BackgroundCache() { Shutdown(); }
+
+    BackgroundCache(const BackgroundCache&) = delete;
+    BackgroundCache& operator=(const BackgroundCache&) = delete;
+
+    void SetEnabled(bool enabled);
+    // `ctx` is the unshaken context; `shake_x`/`shake_y` are screen pixels.
+    void Draw(SDL_Renderer* renderer, const RenderContext& ctx, const Assets& assets, TextureId land,
+              SDL_Color land_tint, int shake_x = 0, int shake_y = 0);
+    // Redraws on the next Draw; for SDL_RENDER_TARGETS_RESET.
+    void Invalidate() { valid_ = false; }
+    void Shutdown();
+
+    int Redraws() const { return redraws_; }
+
+private:
+    SDL_Texture* target_ = nullptr;
+    bool enabled_ = true;
+    bool unsupported_ = false;  // target creation failed; stop retrying
+    bool valid_ = false;
+    TextureId land_ = TextureId::kLand0;
+    SDL_Color land_tint_{255, 255, 255, 255};
+    int redraws_ = 0;
+    // Composes straight to the renderer (or the target); separate from the
+    // frame's queue, which is only flushed once everything else is queued.
+    RenderQueue queue_;
+
+    bool CreateTarget(SDL_Renderer* renderer);
+    void Compose(SDL_Renderer* renderer, const RenderContext& ctx, const Assets& assets, TextureId land,
+                 SDL_Color land_tint);
+};
@@ -1,112 +1,165 @@
 #include "BitmapFont.h"
 
-#include <SDL2/SDL_image.h>
-#include <fstream>
-#include <sstream>
-
-bool BitmapFont::ParseCharAttribute(const std::string& line, const std::string& key, int* value) {
-    const std::string token = key + "=\"";
-    const std::size_t start = line.find(token);
-    if (start == std::string::npos) {
-        return false;
-    }
-    const std::size_t value_start = start + token.size();
-    const std::size_t value_end = line.find('"', value_start);
-    if (value_end == std::string::npos) {
-        return false;
-    }
-    *value = std::stoi(line.substr(value_start, value_end - value_start));
-    return true;
-}
+#include <algorithm>
+#include <cstring>
+
+#include "Assets.h"
+#include "FontFormat.h"
+#include "AssetArchive.h"
 
-bool BitmapFont::Load(SDL_Renderer* renderer, const std::string& image_path, const std::string& xml_path) {
+bool BitmapFont::Load(const TextureAsset& texture, const std::string& path) {
     Unload();
 
-    SDL_Surface* surface = IMG_Load(image_path.c_str());
-    if (!surface) {
+    if (!texture.texture) {
         return false;
     }
-    texture_ = SDL_CreateTextureFromSurface(renderer, surface);
-    texture_w_ = surface->w;
-    texture_h_ = surface->h;
-    SDL_FreeSurface(surface);
-    if (!texture_) {
+    AssetFile file;
+    FontDescriptor descriptor;
+    std::string error;
+    if (!file.Open(path) || !ParseFont(file.Data(), file.Size(), &descriptor, &error)) {
+        if (!error.empty()) {
+            SDL_Log("font %s: %s", path.c_str(), error.c_str());
+        }
         return false;
     }
 
-    std::ifstream file(xml_path);
-    if (!file.is_open()) {
-        Unload();
-        return false;
-    }
+    texture_ = texture.texture;
+    line_height_ = descriptor.line_height;
 
-    std::string line;
-    while (std::getline(file, line)) {
-        if (line.find("lineHeight") != std::string::npos) {
-            ParseCharAttribute(line, "lineHeight", &line_height_);
-        }
-        if (line.find("<char ") == std::string::npos) {
+    // Single-page fonts only: glyphs on other pages or outside Latin-1 are
+    // dropped.
+    for (const FontChar& source : descriptor.chars) {
+        if (source.id >= glyphs_.size() || source.page != 0) {
             continue;
         }
-        int id = 0;
-        Glyph glyph;
-        if (!ParseCharAttribute(line, "id", &id)) {
-            continue;
+        Glyph& glyph = glyphs_[source.id];
+        glyph.src = SDL_Rect{texture.src.x + source.x, texture.src.y + source.y, source.width, source.height};
+        glyph.xoffset = source.xoffset;
+        glyph.yoffset = source.yoffset;
+        glyph.xadvance = source.xadvance;
+        glyph.present = true;
+    }
+    for (const FontKerning& source : descriptor.kernings) {
+        if (source.first < glyphs_.size() && source.second < glyphs_.size() && source.amount != 0) {
+            kerning_.push_back(KerningPair{static_cast<std::uint16_t>((source.first << 8) | source.second),
+                                           static_cast<std::int16_t>(source.amount)});
         }
-        ParseCharAttribute(line, "x", &glyph.src.x);
-        ParseCharAttribute(line, "y", &glyph.src.y);
-        ParseCharAttribute(line, "width", &glyph.src.w);
-        ParseCharAttribute(line, "height", &glyph.src.h);
-        ParseCharAttribute(line, "xoffset", &glyph.xoffset);
-        ParseCharAttribute(line, "yoffset", &glyph.yoffset);
-        ParseCharAttribute(line, "xadvance", &glyph.xadvance);
-        glyphs_[id] = glyph;
     }
+    std::sort(kerning_.begin(), kerning_.end(),
+              [](const KerningPair& a, const KerningPair& b) { return a.pair < b.pair; });
 
     return true;
 }
 
-void BitmapFont::Unload() {
-    if (texture_) {
-        SDL_DestroyTexture(texture_);
-        texture_ = nullptr;
+int BitmapFont::Kerning(unsigned char first, unsigned char second) const {
+    if (kerning_.empty()) {
+        return 0;
     }
-    texture_w_ = 0;
-    texture_h_ = 0;
+    const std::uint16_t pair = static_cast<std::uint16_t>((first << 8) | second);
+    auto it = std::lower_bound(kerning_.begin(), kerning_.end(), pair,
+                               [](const KerningPair& entry, std::uint16_t key) { return entry.pair < key; });
+    return (it != kerning_.end() && it->pair == pair) ? it->amount : 0;
+}
+
+void BitmapFont::Unload() {
+    texture_ = nullptr;
     line_height_ = 0;
-    glyphs_.clear();
+    glyphs_.fill(Glyph{});
+    kerning_.clear();
+    layout_cache_.fill(TextLayout{});
+    layout_clock_ = 0;
+}
+
+const TextLayout& BitmapFont::Layout(const char* text, int length) const {
+    layout_clock_++;
+    TextLayout* victim = &layout_cache_[0];
+    for (TextLayout& entry : layout_cache_) {
+        if (entry.length == length && std::memcmp(entry.text, text, static_cast<std::size_t>(length)) == 0) {
+            entry.last_used = layout_clock_;
+            return entry;
+        }
+        if (entry.last_used < victim->last_used) {
+            victim = &entry;
+        }
+    }
+
+    TextLayout& layout = *victim;
+    std::memcpy(layout.text, text, static_cast<std::size_t>(length));
+    layout.length = length;
+    layout.last_used = layout_clock_;
+    layout.quad_count = 0;
+    int cursor = 0;
+    for (int i = 0; i < length; ++i) {
+        if (i > 0) {
+            cursor += Kerning(static_cast<unsigned char>(text[i - 1]), static_cast<unsigned char>(text[i]));
+        }
+        const Glyph& glyph = glyphs_[static_cast<unsigned char>(text[i])];
+        if (!glyph.present) {
+            cursor += kMissingAdvance;
+            continue;
+        }
+        layout.quads[layout.quad_count++] = TextQuad{glyph.src, cursor + glyph.xoffset, glyph.yoffset};
+        cursor += glyph.xadvance;
+    }
+    layout.width = cursor;
+    return layout;
 }
 
-void BitmapFont::Draw(SDL_Renderer* renderer, const RenderContext& ctx, const std::string& text, float x, float y, float scale,
+float BitmapFont::MeasureText(const char* text, float scale) const {
+    int width = 0;
+    const char* const start = text;
+    int remaining = static_cast<int>(std::strlen(text));
+    while (remaining > 0) {
+        const int run = std::min(remaining, TextLayout::kMaxGlyphs);
+        if (text != start) {
+            width += Kerning(static_cast<unsigned char>(text[-1]), static_cast<unsigned char>(text[0]));
+        }
+        width += Layout(text, run).width;
+        text += run;
+        remaining -= run;
+    }
+    return static_cast<float>(width) * scale;
+}
+
+void BitmapFont::Draw(RenderQueue& queue, const RenderContext& ctx, const char* text, float x, float y, float scale,
                       SDL_Color color, int* out_width) const {
-    if (!texture_) {
+    TextBatch batch(queue, this);
+    batch.Add(ctx, text, x, y, scale, color, out_width);
+}
+
+void TextBatch::Add(const RenderContext& ctx, const char* text, float x, float y, float scale, SDL_Color color,
+                    int* out_width) {
+    if (!font_ || !font_->IsLoaded()) {
         if (out_width) {
             *out_width = 0;
         }
         return;
     }
 
-    SDL_SetTextureColorMod(texture_, color.r, color.g, color.b);
-    SDL_SetTextureAlphaMod(texture_, color.a);
-
-    float cursor = x;
-    for (char ch : text) {
-        auto it = glyphs_.find(static_cast<int>(ch));
-        if (it == glyphs_.end()) {
-            cursor += 8.0f * scale;
-            continue;
+    int pen = 0;
+    const char* const start = text;
+    int remaining = static_cast<int>(std::strlen(text));
+    while (remaining > 0) {
+        const int run = std::min(remaining, TextLayout::kMaxGlyphs);
+        if (text != start) {
+            pen += font_->Kerning(static_cast<unsigned char>(text[-1]), static_cast<unsigned char>(text[0]));
+        }
+        const TextLayout& layout = font_->Layout(text, run);
+        for (int i = 0; i < layout.quad_count; ++i) {
+            const TextQuad& quad = layout.quads[i];
+            const SDL_FRect dst{
+                ctx.offset_x + (x + static_cast<float>(pen + quad.x) * scale) * ctx.scale,
+                ctx.offset_y + (y + static_cast<float>(quad.y) * scale) * ctx.scale,
+                static_cast<float>(quad.src.w) * scale * ctx.scale,
+                static_cast<float>(quad.src.h) * scale * ctx.scale};
+            queue_.AddSprite(font_->Texture(), quad.src, dst, color);
         }
-        const Glyph& glyph = it->second;
-        SDL_FRect dst{
-            ctx.offset_x + (cursor + static_cast<float>(glyph.xoffset) * scale) * ctx.scale,
-            ctx.offset_y + (y + static_cast<float>(glyph.yoffset) * scale) * ctx.scale,
-            static_cast<float>(glyph.src.w) * scale * ctx.scale,
-            static_cast<float>(glyph.src.h) * scale * ctx.scale};
-        SDL_RenderCopyF(renderer, texture_, &glyph.src, &dst);
-        cursor += static_cast<float>(glyph.xadvance) * scale;
+        pen += layout.width;
+        text += run;
+        remaining -= run;
     }
 
     if (out_width) {
-        *out_width = static_cast<int>(cursor - x);
+        *out_width = static_cast<int>(static_cast<float>(pen) * scale);
     }
 }
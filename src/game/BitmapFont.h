@@ -1,34 +1,106 @@
 #pragma once
 
 #include <SDL2/SDL.h>
+#include <array>
+#include <cstddef>
+#include <cstdint>
 #include <string>
-#include <unordered_map>
+#include <vector>
 
 #include "RenderContext.h"
+#include "RenderQueue.h"
+
+struct TextureAsset;
 
 struct Glyph {
-    SDL_Rect src;
+    SDL_Rect src{0, 0, 0, 0};
     int xoffset = 0;
     int yoffset = 0;
     int xadvance = 0;
+    bool present = false;
+};
+
+// One placed glyph, in unscaled font units relative to the text origin.
+struct TextQuad {
+    SDL_Rect src;
+    int x;
+    int y;
+};
+
+// A laid-out run of up to kMaxGlyphs characters. Longer strings are laid out
+// as consecutive runs.
+struct TextLayout {
+    static constexpr int kMaxGlyphs = 16;
+
+    char text[kMaxGlyphs];
+    int length = -1;  // -1 marks an unused cache slot
+    int quad_count = 0;
+    int width = 0;  // advances plus kerning, font units
+    unsigned int last_used = 0;
+    std::array<TextQuad, kMaxGlyphs> quads;
 };
 
 class BitmapFont {
 public:
-    bool Load(SDL_Renderer* renderer, const std::string& image_path, const std::string& xml_path);
+    // The font does not own `texture`; glyph rects are stored relative to the
+    // texture page so fonts packed into an atlas draw from the shared page.
+    // `path` is a BMFont XML or binary .fnt descriptor (see FontFormat.h).
+    bool Load(const TextureAsset& texture, const std::string& path);
     void Unload();
 
-    void Draw(SDL_Renderer* renderer, const RenderContext& ctx, const std::string& text, float x, float y, float scale,
+    // Queues one quad per glyph; the queue merges them (and any other text
+    // on the same page) into one submission.
+    void Draw(RenderQueue& queue, const RenderContext& ctx, const char* text, float x, float y, float scale,
               SDL_Color color, int* out_width = nullptr) const;
+    void Draw(RenderQueue& queue, const RenderContext& ctx, const std::string& text, float x, float y, float scale,
+              SDL_Color color, int* out_width = nullptr) const {
+        Draw(queue, ctx, text.c_str(), x, y, scale, color, out_width);
+    }
+
+    // Horizontal advance of `text` in world units at `scale`.
+    float MeasureText(const char* text, float scale) const;
+
+    // Returns the layout of `text[0, length)`, length <= TextLayout::kMaxGlyphs.
+    // Recently used strings come from a small LRU cache keyed by content, so
+    // a number that did not change since the last frame is not laid out again.
+    const TextLayout& Layout(const char* text, int length) const;
 
+    // Extra advance between a pair of characters; 0 for fonts without kerning.
+    int Kerning(unsigned char first, unsigned char second) const;
+
+    bool IsLoaded() const { return texture_ != nullptr; }
     int LineHeight() const { return line_height_; }
+    SDL_Texture* Texture() const { return texture_; }
 
 private:
+    static constexpr int kLayoutCacheSize = 16;
+    static constexpr int kMissingAdvance = 8;
+
     SDL_Texture* texture_ = nullptr;
-    int texture_w_ = 0;
-    int texture_h_ = 0;
     int line_height_ = 0;
-    std::unordered_map<int, Glyph> glyphs_;
+    std::array<Glyph, 256> glyphs_{};
+
+    struct KerningPair {
+        std::uint16_t pair;  // first << 8 | second
+        std::int16_t amount;
+    };
+    std::vector<KerningPair> kerning_;  // sorted by pair
+
+    // Render-thread only; mutable so lookups stay usable through const fonts.
+    mutable std::array<TextLayout, kLayoutCacheSize> layout_cache_{};
+    mutable unsigned int layout_clock_ = 0;
+};
 
-    static bool ParseCharAttribute(const std::string& line, const std::string& key, int* value);
+// Several strings in one font, queued one after another. Each string's colour
+// rides in its glyphs' vertex colours, so they still merge into one draw.
+class TextBatch {
+public:
+    TextBatch(RenderQueue& queue, const BitmapFont* font) : queue_(queue), font_(font) {}
+
+    void Add(const RenderContext& ctx, const char* text, float x, float y, float scale, SDL_Color color,
+             int* out_width = nullptr);
+
+private:
+    RenderQueue& queue_;
+    const BitmapFont* font_;
 };
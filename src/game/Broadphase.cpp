@@ -0,0 +1,139 @@
+#include "Broadphase.h"
+
+#include <algorithm>
+#include <cmath>
+
+UniformGrid::UniformGrid(const SDL_FRect& bounds, float cell_size, int capacity)
+    : bounds_(bounds),
+      inv_cell_size_(1.0f / cell_size),
+      columns_(std::max(1, static_cast<int>(std::ceil(bounds.w / cell_size)))),
+      rows_(std::max(1, static_cast<int>(std::ceil(bounds.h / cell_size)))),
+      entries_(static_cast<std::size_t>(capacity)),
+      cells_(static_cast<std::size_t>(columns_ * rows_)),
+      visited_(static_cast<std::size_t>(capacity), 0u) {}
+
+void UniformGrid::Update(int id, const SDL_FRect& box, std::uint32_t category) {
+    Entry& entry = entries_[id];
+    entry.box = box;
+    entry.category = category;
+    const int min_x = CellX(box.x);
+    const int max_x = CellX(box.x + box.w);
+    const int min_y = CellY(box.y);
+    const int max_y = CellY(box.y + box.h);
+    if (entry.active && min_x == entry.min_x && max_x == entry.max_x && min_y == entry.min_y &&
+        max_y == entry.max_y) {
+        return;
+    }
+    if (entry.active) {
+        Unlink(id);
+    } else {
+        entry.active = true;
+        count_++;
+    }
+    entry.min_x = min_x;
+    entry.max_x = max_x;
+    entry.min_y = min_y;
+    entry.max_y = max_y;
+    Link(id);
+}
+
+void UniformGrid::Remove(int id) {
+    Entry& entry = entries_[id];
+    if (!entry.active) {
+        return;
+    }
+    Unlink(id);
+    entry.active = false;
+    count_--;
+}
+
+void UniformGrid::Clear() {
+    for (auto& cell : cells_) {
+        cell.clear();
+    }
+    for (auto& entry : entries_) {
+        entry.active = false;
+    }
+    count_ = 0;
+}
+
+void UniformGrid::QueryPairs(std::uint32_t mask_a, std::uint32_t mask_b,
+                             std::vector<std::pair<int, int>>* out_pairs) const {
+    out_pairs->clear();
+    for (int y = 0; y < rows_; ++y) {
+        for (int x = 0; x < columns_; ++x) {
+            const std::vector<int>& cell = cells_[y * columns_ + x];
+            for (std::size_t i = 0; i < cell.size(); ++i) {
+                const Entry& first = entries_[cell[i]];
+                for (std::size_t j = i + 1; j < cell.size(); ++j) {
+                    const Entry& second = entries_[cell[j]];
+                    const bool forward = (first.category & mask_a) && (second.category & mask_b);
+                    if (!forward && !((first.category & mask_b) && (second.category & mask_a))) {
+                        continue;
+                    }
+                    // A pair sharing several cells is reported only from the
+                    // first cell of their shared range.
+                    if (x != std::max(first.min_x, second.min_x) || y != std::max(first.min_y, second.min_y)) {
+                        continue;
+                    }
+                    if (Overlaps(first.box, second.box)) {
+                        out_pairs->emplace_back(forward ? cell[i] : cell[j], forward ? cell[j] : cell[i]);
+                    }
+                }
+            }
+        }
+    }
+}
+
+int UniformGrid::CellX(float x) const {
+    const int cell = static_cast<int>(std::floor((x - bounds_.x) * inv_cell_size_));
+    return std::min(std::max(cell, 0), columns_ - 1);
+}
+
+int UniformGrid::CellY(float y) const {
+    const int cell = static_cast<int>(std::floor((y - bounds_.y) * inv_cell_size_));
+    return std::min(std::max(cell, 0), rows_ - 1);
+}
+
+void UniformGrid::Link(int id) {
+    Entry& entry = entries_[id];
+    entry.positions.clear();
+    for (int y = entry.min_y; y <= entry.max_y; ++y) {
+        for (int x = entry.min_x; x <= entry.max_x; ++x) {
+            std::vector<int>& cell = cells_[y * columns_ + x];
+            entry.positions.push_back(static_cast<int>(cell.size()));
+            cell.push_back(id);
+        }
+    }
+}
+
+void UniformGrid::Unlink(int id) {
+    const Entry& entry = entries_[id];
+    int local = 0;
+    for (int y = entry.min_y; y <= entry.max_y; ++y) {
+        for (int x = entry.min_x; x <= entry.max_x; ++x) {
+            std::vector<int>& cell = cells_[y * columns_ + x];
+            const int position = entry.positions[local++];
+            const int moved = cell.back();
+            cell[position] = moved;
+            cell.pop_back();
+            if (moved != id) {
+                Entry& moved_entry = entries_[moved];
+                moved_entry.positions[LocalCell(moved_entry, x, y)] = position;
+            }
+        }
+    }
+}
+
+std::uint32_t UniformGrid::NextStamp() const {
+    if (++query_stamp_ == 0) {
+        // Wrapped: clear old stamps so none matches by accident.
+        std::fill(visited_.begin(), visited_.end(), 0u);
+        query_stamp_ = 1;
+    }
+    return query_stamp_;
+}
+
+bool UniformGrid::Overlaps(const SDL_FRect& a, const SDL_FRect& b) {
+    return !(a.x > b.x + b.w || a.x + a.w < b.x || a.y > b.y + b.h || a.y + a.h < b.y);
+}
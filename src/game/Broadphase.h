@@ -0,0 +1,95 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// Uniform-grid broadphase over design space. Entities are small integer ids
+// (an entity pool's slot, offset per pool) with a bounding box and a category
+// bit. Each entity is listed in every cell its box touches; boxes outside the
+// bounds clamp to the border cells. Update only re-buckets an entity when the
+// range of cells it covers changes, so a tick of small moves mostly costs a
+// compare per entity. Queries return candidates whose boxes overlap (edges
+// touching count); callers run any exact test.
+class UniformGrid {
+public:
+    UniformGrid(const SDL_FRect& bounds, float cell_size, int capacity);
+
+    // Inserts `id` or moves it to `box`. `category` is a single bit used by
+    // the query masks.
+    void Update(int id, const SDL_FRect& box, std::uint32_t category);
+    void Remove(int id);
+    void Clear();
+
+    int Count() const { return count_; }
+    int Capacity() const { return static_cast<int>(entries_.size()); }
+
+    // Calls `fn(id)` once for every entity in a `mask` category whose box
+    // overlaps `box`; stops early when `fn` returns false.
+    template <typename Fn>
+    void Query(const SDL_FRect& box, std::uint32_t mask, Fn&& fn) const;
+    // Every overlapping pair with one side in `mask_a` and the other in
+    // `mask_b`, each reported once (first id in mask_a when the masks differ).
+    void QueryPairs(std::uint32_t mask_a, std::uint32_t mask_b, std::vector<std::pair<int, int>>* out_pairs) const;
+
+private:
+    struct Entry {
+        SDL_FRect box{0.0f, 0.0f, 0.0f, 0.0f};
+        std::uint32_t category = 0;
+        bool active = false;
+        // Covered cell range, inclusive.
+        int min_x = 0;
+        int min_y = 0;
+        int max_x = -1;
+        int max_y = -1;
+        // Where this id sits in each covered cell, row-major over the range,
+        // so unlinking is a swap-remove instead of a search.
+        std::vector<int> positions;
+    };
+
+    SDL_FRect bounds_;
+    float inv_cell_size_;
+    int columns_;
+    int rows_;
+    int count_ = 0;
+    std::vector<Entry> entries_;
+    std::vector<std::vector<int>> cells_;
+    // Per-entry stamp so an entity spanning several cells is visited once per
+    // query. Queries are const but not reentrant.
+    mutable std::vector<std::uint32_t> visited_;
+    mutable std::uint32_t query_stamp_ = 0;
+
+    int CellX(float x) const;
+    int CellY(float y) const;
+    void Link(int id);
+    void Unlink(int id);
+    static int LocalCell(const Entry& entry, int x, int y) {
+        return (y - entry.min_y) * (entry.max_x - entry.min_x + 1) + x - entry.min_x;
+    }
+    std::uint32_t NextStamp() const;
+    static bool Overlaps(const SDL_FRect& a, const SDL_FRect& b);
+};
+
+template <typename Fn>
+void UniformGrid::Query(const SDL_FRect& box, std::uint32_t mask, Fn&& fn) const {
+    const std::uint32_t stamp = NextStamp();
+    const int min_x = CellX(box.x);
+    const int max_x = CellX(box.x + box.w);
+    const int min_y = CellY(box.y);
+    const int max_y = CellY(box.y + box.h);
+    for (int y = min_y; y <= max_y; ++y) {
+        for (int x = min_x; x <= max_x; ++x) {
+            for (int id : cells_[y * columns_ + x]) {
+                const Entry& entry = entries_[id];
+                if ((entry.category & mask) == 0 || visited_[id] == stamp) {
+                    continue;
+                }
+                visited_[id] = stamp;
+                if (Overlaps(box, entry.box) && !fn(id)) {
+                    return;
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,111 @@
+#include "Collision.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+// Earliest t in [0, 1] where start + t * delta enters `rect`.
+bool RayRect(SDL_FPoint start, SDL_FPoint delta, const SDL_FRect& rect, float* out_t) {
+    float t_min = 0.0f;
+    float t_max = 1.0f;
+    const float origin[2] = {start.x, start.y};
+    const float direction[2] = {delta.x, delta.y};
+    const float low[2] = {rect.x, rect.y};
+    const float high[2] = {rect.x + rect.w, rect.y + rect.h};
+    for (int axis = 0; axis < 2; ++axis) {
+        if (direction[axis] == 0.0f) {
+            if (origin[axis] < low[axis] || origin[axis] > high[axis]) {
+                return false;
+            }
+            continue;
+        }
+        const float inv = 1.0f / direction[axis];
+        float t0 = (low[axis] - origin[axis]) * inv;
+        float t1 = (high[axis] - origin[axis]) * inv;
+        if (t0 > t1) {
+            std::swap(t0, t1);
+        }
+        t_min = std::max(t_min, t0);
+        t_max = std::min(t_max, t1);
+        if (t_min > t_max) {
+            return false;
+        }
+    }
+    *out_t = t_min;
+    return true;
+}
+
+// Earliest t in [0, 1] where start + t * delta comes within `radius` of
+// `center`; the start is known to be outside.
+bool RayCircle(SDL_FPoint start, SDL_FPoint delta, SDL_FPoint center, float radius, float* out_t) {
+    const float a = delta.x * delta.x + delta.y * delta.y;
+    if (a == 0.0f) {
+        return false;
+    }
+    const float mx = start.x - center.x;
+    const float my = start.y - center.y;
+    const float b = mx * delta.x + my * delta.y;
+    const float c = mx * mx + my * my - radius * radius;
+    const float discriminant = b * b - a * c;
+    if (discriminant < 0.0f) {
+        return false;
+    }
+    const float t = (-b - std::sqrt(discriminant)) / a;
+    if (t < 0.0f || t > 1.0f) {
+        return false;
+    }
+    *out_t = t;
+    return true;
+}
+}
+
+bool CircleRectOverlap(SDL_FPoint center, float radius, const SDL_FRect& rect) {
+    const float dx = center.x - std::max(rect.x, std::min(center.x, rect.x + rect.w));
+    const float dy = center.y - std::max(rect.y, std::min(center.y, rect.y + rect.h));
+    return dx * dx + dy * dy <= radius * radius;
+}
+
+bool SweepCircleRect(SDL_FPoint start, SDL_FPoint delta, float radius, const SDL_FRect& rect, float* out_t) {
+    if (CircleRectOverlap(start, radius, rect)) {
+        *out_t = 0.0f;
+        return true;
+    }
+    // The rect grown by the radius with rounded corners is two crossed boxes
+    // plus a circle at each corner; the centre's path hits it at the earliest
+    // of the six.
+    const SDL_FRect wide{rect.x - radius, rect.y, rect.w + radius * 2.0f, rect.h};
+    const SDL_FRect tall{rect.x, rect.y - radius, rect.w, rect.h + radius * 2.0f};
+    const SDL_FPoint corners[4] = {{rect.x, rect.y},
+                                   {rect.x + rect.w, rect.y},
+                                   {rect.x, rect.y + rect.h},
+                                   {rect.x + rect.w, rect.y + rect.h}};
+    bool hit = false;
+    float best = 1.0f;
+    float t = 0.0f;
+    if (RayRect(start, delta, wide, &t) && t <= best) {
+        best = t;
+        hit = true;
+    }
+    if (RayRect(start, delta, tall, &t) && t <= best) {
+        best = t;
+        hit = true;
+    }
+    for (const SDL_FPoint& corner : corners) {
+        if (RayCircle(start, delta, corner, radius, &t) && t <= best) {
+            best = t;
+            hit = true;
+        }
+    }
+    if (hit) {
+        *out_t = best;
+    }
+    return hit;
+}
+
+SDL_FRect UnionRect(const SDL_FRect& a, const SDL_FRect& b) {
+    const float left = std::min(a.x, b.x);
+    const float top = std::min(a.y, b.y);
+    const float right = std::max(a.x + a.w, b.x + b.w);
+    const float bottom = std::max(a.y + a.h, b.y + b.h);
+    return SDL_FRect{left, top, right - left, bottom - top};
+}
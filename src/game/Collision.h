@@ -0,0 +1,18 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+
+// Narrow-phase tests in design units. Touching edges count as contact, as in
+// the broadphase.
+
+bool CircleRectOverlap(SDL_FPoint center, float radius, const SDL_FRect& rect);
+
+// Sweeps a circle from `start` by `delta` against a rect that holds still
+// (pass motion relative to the rect when both move). On contact returns true
+// with the fraction of `delta` travelled in `out_t`; 0 when the circle
+// already overlaps at `start`. A zero radius sweeps a point, which against a
+// rect grown by a box's half-size is a swept box test.
+bool SweepCircleRect(SDL_FPoint start, SDL_FPoint delta, float radius, const SDL_FRect& rect, float* out_t);
+
+// Smallest box holding both.
+SDL_FRect UnionRect(const SDL_FRect& a, const SDL_FRect& b);
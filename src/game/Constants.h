@@ -6,4 +6,13 @@ constexpr int kScreenHeight = 480;
 constexpr int kDesignWidth = 1216;
 constexpr int kDesignHeight = 800;
 constexpr int kTargetFps = 60;
+constexpr int kSimHz = 120;
+// Longest real-time gap fed into the simulation per frame; anything beyond is
+// dropped so a stall does not turn into a burst of catch-up ticks.
+constexpr float kMaxFrameSeconds = 0.1f;
+// Mixer output (format is MIX_DEFAULT_FORMAT). tools/SoundBankCompiler decodes
+// sounds to exactly this, so changing it means rebuilding the sound bank.
+constexpr int kAudioFrequency = 44100;
+constexpr int kAudioChannels = 2;
+constexpr int kAudioChunkSamples = 1024;
 }
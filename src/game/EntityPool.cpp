@@ -0,0 +1,60 @@
+#include "EntityPool.h"
+
+PoolIndex::PoolIndex(int capacity)
+    : dense_to_slot_(static_cast<std::size_t>(capacity)),
+      slot_to_dense_(static_cast<std::size_t>(capacity)),
+      generations_(static_cast<std::size_t>(capacity), 0u) {
+    free_slots_.reserve(static_cast<std::size_t>(capacity));
+    Clear();
+}
+
+int PoolIndex::Add() {
+    if (Full()) {
+        return -1;
+    }
+    const std::uint32_t slot = free_slots_.back();
+    free_slots_.pop_back();
+    const int index = size_++;
+    dense_to_slot_[index] = slot;
+    slot_to_dense_[slot] = static_cast<std::uint32_t>(index);
+    return index;
+}
+
+int PoolIndex::Remove(int index) {
+    const std::uint32_t slot = dense_to_slot_[index];
+    generations_[slot]++;
+    free_slots_.push_back(slot);
+
+    const int last = --size_;
+    if (index == last) {
+        return -1;
+    }
+    const std::uint32_t moved_slot = dense_to_slot_[last];
+    dense_to_slot_[index] = moved_slot;
+    slot_to_dense_[moved_slot] = static_cast<std::uint32_t>(index);
+    return last;
+}
+
+void PoolIndex::Clear() {
+    for (int i = 0; i < size_; ++i) {
+        generations_[dense_to_slot_[i]]++;
+    }
+    size_ = 0;
+    // Hand out low slots first so a fresh pool's handles read 0, 1, 2...
+    free_slots_.clear();
+    for (int slot = Capacity() - 1; slot >= 0; --slot) {
+        free_slots_.push_back(static_cast<std::uint32_t>(slot));
+    }
+}
+
+EntityHandle PoolIndex::HandleAt(int index) const {
+    const std::uint32_t slot = dense_to_slot_[index];
+    return EntityHandle{slot, generations_[slot]};
+}
+
+int PoolIndex::IndexOf(EntityHandle handle) const {
+    if (handle.slot >= slot_to_dense_.size() || generations_[handle.slot] != handle.generation) {
+        return -1;
+    }
+    return static_cast<int>(slot_to_dense_[handle.slot]);
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Refers to one pooled entity independent of where it currently sits in the
+// dense arrays. Stale once the entity is removed: the slot's generation moves
+// on, so a later entity reusing the slot does not match.
+struct EntityHandle {
+    std::uint32_t slot = 0xffffffffu;
+    std::uint32_t generation = 0;
+};
+
+// Index bookkeeping for a fixed-capacity structure-of-arrays pool. Live
+// entities occupy dense indices [0, Size()); removal swaps the last entity
+// into the hole, so the owner keeps its field arrays packed by moving element
+// `Size()` (after the call) into the removed index. Everything is allocated
+// up front and never grows.
+class PoolIndex {
+public:
+    explicit PoolIndex(int capacity);
+
+    int Size() const { return size_; }
+    int Capacity() const { return static_cast<int>(slot_to_dense_.size()); }
+    bool Full() const { return size_ == Capacity(); }
+
+    // Claims dense index Size() for a new entity; -1 when the pool is full.
+    int Add();
+    // Removes the entity at `index`. Returns the dense index whose fields the
+    // owner must copy into `index`, or -1 when `index` was the last one.
+    int Remove(int index);
+    void Clear();
+
+    EntityHandle HandleAt(int index) const;
+    // Dense index of a live entity, or -1 when the handle is stale.
+    int IndexOf(EntityHandle handle) const;
+    // Dense index of the entity in `slot`; only meaningful while it is live
+    // (for structures keyed by slot, like UniformGrid ids).
+    int IndexOfSlot(std::uint32_t slot) const { return static_cast<int>(slot_to_dense_[slot]); }
+
+private:
+    std::vector<std::uint32_t> dense_to_slot_;
+    std::vector<std::uint32_t> slot_to_dense_;
+    std::vector<std::uint32_t> generations_;
+    std::vector<std::uint32_t> free_slots_;
+    int size_ = 0;
+};
@@ -0,0 +1,470 @@
+#include "FontFormat.h"
+
+#include <cstring>
+#include <string_view>
+
+namespace {
+constexpr unsigned char kBinaryVersion = 3;
+constexpr std::size_t kBinaryHeaderSize = 4;
+constexpr std::size_t kBlockHeaderSize = 5;
+constexpr std::size_t kInfoFixedSize = 14;
+constexpr std::size_t kCommonSize = 15;
+constexpr std::size_t kCharRecordSize = 20;
+constexpr std::size_t kKerningRecordSize = 10;
+
+enum BlockType : unsigned char {
+    kBlockInfo = 1,
+    kBlockCommon = 2,
+    kBlockPages = 3,
+    kBlockChars = 4,
+    kBlockKerning = 5
+};
+
+bool IsSpace(char c) {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+bool IsNameChar(char c) {
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_' || c == '-';
+}
+
+bool ParseInt(std::string_view text, int* out) {
+    std::size_t i = 0;
+    bool negative = false;
+    if (i < text.size() && (text[i] == '-' || text[i] == '+')) {
+        negative = text[i] == '-';
+        i++;
+    }
+    if (i == text.size()) {
+        return false;
+    }
+    long value = 0;
+    for (; i < text.size(); ++i) {
+        if (text[i] < '0' || text[i] > '9' || value > 100000000) {
+            return false;
+        }
+        value = value * 10 + (text[i] - '0');
+    }
+    *out = static_cast<int>(negative ? -value : value);
+    return true;
+}
+
+// Walks the `key="value"` pairs of one XML element. Stops at the end of the
+// tag, leaving `cursor_` on the '/' or '>'.
+class AttributeReader {
+public:
+    AttributeReader(const char* cursor, const char* end) : cursor_(cursor), end_(end) {}
+
+    bool Next(std::string_view* key, std::string_view* value) {
+        while (cursor_ < end_ && IsSpace(*cursor_)) {
+            cursor_++;
+        }
+        const char* key_start = cursor_;
+        while (cursor_ < end_ && IsNameChar(*cursor_)) {
+            cursor_++;
+        }
+        if (cursor_ == key_start) {
+            return false;
+        }
+        *key = std::string_view(key_start, static_cast<std::size_t>(cursor_ - key_start));
+        while (cursor_ < end_ && IsSpace(*cursor_)) {
+            cursor_++;
+        }
+        if (cursor_ == end_ || *cursor_ != '=') {
+            malformed_ = true;
+            return false;
+        }
+        cursor_++;
+        while (cursor_ < end_ && IsSpace(*cursor_)) {
+            cursor_++;
+        }
+        if (cursor_ == end_ || (*cursor_ != '"' && *cursor_ != '\'')) {
+            malformed_ = true;
+            return false;
+        }
+        const char quote = *cursor_++;
+        const char* value_start = cursor_;
+        // Values are a few characters long; a plain loop beats memchr here.
+        while (cursor_ < end_ && *cursor_ != quote) {
+            cursor_++;
+        }
+        if (cursor_ == end_) {
+            malformed_ = true;
+            return false;
+        }
+        *value = std::string_view(value_start, static_cast<std::size_t>(cursor_ - value_start));
+        cursor_++;
+        return true;
+    }
+
+    const char* Cursor() const { return cursor_; }
+    bool Malformed() const { return malformed_; }
+
+private:
+    const char* cursor_;
+    const char* end_;
+    bool malformed_ = false;
+};
+
+bool SetError(std::string* out_error, const std::string& message) {
+    if (out_error) {
+        *out_error = message;
+    }
+    return false;
+}
+
+bool ReadIntAttribute(std::string_view key, std::string_view value, int* out, std::string* out_error) {
+    if (!ParseInt(value, out)) {
+        return SetError(out_error, "bad number for " + std::string(key) + ": " + std::string(value));
+    }
+    return true;
+}
+
+bool ParseXml(const char* cursor, const char* end, FontDescriptor* out, std::string* out_error) {
+    std::string_view key;
+    std::string_view value;
+    while (cursor < end) {
+        const void* open = std::memchr(cursor, '<', static_cast<std::size_t>(end - cursor));
+        if (!open) {
+            break;
+        }
+        cursor = static_cast<const char*>(open) + 1;
+        const char* name_start = cursor;
+        while (cursor < end && IsNameChar(*cursor)) {
+            cursor++;
+        }
+        const std::string_view name(name_start, static_cast<std::size_t>(cursor - name_start));
+
+        // Declarations, comments, closing tags and elements we do not use are
+        // skipped up to their '>'.
+        AttributeReader attributes(cursor, end);
+        bool ok = true;
+        if (name == "char") {
+            FontChar glyph;
+            while (ok && attributes.Next(&key, &value)) {
+                int number = 0;
+                if (key == "letter") {
+                    continue;  // some exporters add the glyph itself
+                }
+                ok = ReadIntAttribute(key, value, &number, out_error);
+                if (key == "id") {
+                    glyph.id = static_cast<std::uint32_t>(number);
+                } else if (key == "x") {
+                    glyph.x = number;
+                } else if (key == "y") {
+                    glyph.y = number;
+                } else if (key == "width") {
+                    glyph.width = number;
+                } else if (key == "height") {
+                    glyph.height = number;
+                } else if (key == "xoffset") {
+                    glyph.xoffset = number;
+                } else if (key == "yoffset") {
+                    glyph.yoffset = number;
+                } else if (key == "xadvance") {
+                    glyph.xadvance = number;
+                } else if (key == "page") {
+                    glyph.page = number;
+                }
+            }
+            out->chars.push_back(glyph);
+        } else if (name == "kerning") {
+            FontKerning kerning;
+            while (ok && attributes.Next(&key, &value)) {
+                int number = 0;
+                ok = ReadIntAttribute(key, value, &number, out_error);
+                if (key == "first") {
+                    kerning.first = static_cast<std::uint32_t>(number);
+                } else if (key == "second") {
+                    kerning.second = static_cast<std::uint32_t>(number);
+                } else if (key == "amount") {
+                    kerning.amount = number;
+                }
+            }
+            out->kernings.push_back(kerning);
+        } else if (name == "chars" || name == "kernings") {
+            while (ok && attributes.Next(&key, &value)) {
+                int count = 0;
+                if (key == "count" && ParseInt(value, &count) && count > 0) {
+                    if (name == "chars") {
+                        out->chars.reserve(static_cast<std::size_t>(count));
+                    } else {
+                        out->kernings.reserve(static_cast<std::size_t>(count));
+                    }
+                }
+            }
+        } else if (name == "common") {
+            while (ok && attributes.Next(&key, &value)) {
+                if (key == "lineHeight") {
+                    ok = ReadIntAttribute(key, value, &out->line_height, out_error);
+                } else if (key == "base") {
+                    ok = ReadIntAttribute(key, value, &out->base, out_error);
+                } else if (key == "scaleW") {
+                    ok = ReadIntAttribute(key, value, &out->scale_w, out_error);
+                } else if (key == "scaleH") {
+                    ok = ReadIntAttribute(key, value, &out->scale_h, out_error);
+                }
+            }
+        } else if (name == "info") {
+            while (ok && attributes.Next(&key, &value)) {
+                if (key == "face") {
+                    out->face.assign(value.data(), value.size());
+                } else if (key == "size") {
+                    ok = ReadIntAttribute(key, value, &out->size, out_error);
+                }
+            }
+        } else if (name == "page") {
+            while (ok && attributes.Next(&key, &value)) {
+                if (key == "file") {
+                    out->pages.emplace_back(value.data(), value.size());
+                }
+            }
+        } else {
+            while (attributes.Next(&key, &value)) {
+            }
+        }
+        if (!ok) {
+            return false;
+        }
+        if (attributes.Malformed()) {
+            return SetError(out_error, "malformed attribute in <" + std::string(name) + ">");
+        }
+
+        cursor = attributes.Cursor();
+        const void* close = std::memchr(cursor, '>', static_cast<std::size_t>(end - cursor));
+        if (!close) {
+            return SetError(out_error, "unterminated <" + std::string(name) + ">");
+        }
+        cursor = static_cast<const char*>(close) + 1;
+    }
+    if (out->chars.empty()) {
+        return SetError(out_error, "no <char> elements");
+    }
+    return true;
+}
+
+std::uint32_t ReadU32(const unsigned char* p) {
+    return static_cast<std::uint32_t>(p[0]) | (static_cast<std::uint32_t>(p[1]) << 8) |
+           (static_cast<std::uint32_t>(p[2]) << 16) | (static_cast<std::uint32_t>(p[3]) << 24);
+}
+
+int ReadU16(const unsigned char* p) {
+    return static_cast<int>(p[0]) | (static_cast<int>(p[1]) << 8);
+}
+
+std::size_t BoundedLength(const unsigned char* text, std::size_t limit) {
+    const void* nul = std::memchr(text, 0, limit);
+    return nul ? static_cast<std::size_t>(static_cast<const unsigned char*>(nul) - text) : limit;
+}
+
+int ReadS16(const unsigned char* p) {
+    return static_cast<int>(static_cast<std::int16_t>(static_cast<std::uint16_t>(ReadU16(p))));
+}
+
+bool ParseBinary(const unsigned char* data, std::size_t size, FontDescriptor* out, std::string* out_error) {
+    if (data[3] != kBinaryVersion) {
+        return SetError(out_error, "unsupported binary version " + std::to_string(data[3]));
+    }
+    std::size_t offset = kBinaryHeaderSize;
+    while (offset < size) {
+        if (size - offset < kBlockHeaderSize) {
+            return SetError(out_error, "truncated block header");
+        }
+        const unsigned char type = data[offset];
+        const std::size_t block_size = ReadU32(data + offset + 1);
+        offset += kBlockHeaderSize;
+        if (block_size > size - offset) {
+            return SetError(out_error, "block " + std::to_string(type) + " overruns the file");
+        }
+        const unsigned char* block = data + offset;
+        offset += block_size;
+
+        switch (type) {
+        case kBlockInfo: {
+            if (block_size < kInfoFixedSize) {
+                return SetError(out_error, "info block too small");
+            }
+            const int font_size = ReadS16(block);
+            out->size = font_size < 0 ? -font_size : font_size;  // negative: matched char height
+            const unsigned char* name = block + kInfoFixedSize;
+            out->face.assign(reinterpret_cast<const char*>(name), BoundedLength(name, block_size - kInfoFixedSize));
+            break;
+        }
+        case kBlockCommon:
+            if (block_size < kCommonSize) {
+                return SetError(out_error, "common block too small");
+            }
+            out->line_height = ReadU16(block);
+            out->base = ReadU16(block + 2);
+            out->scale_w = ReadU16(block + 4);
+            out->scale_h = ReadU16(block + 6);
+            break;
+        case kBlockPages: {
+            std::size_t start = 0;
+            while (start < block_size) {
+                const std::size_t length = BoundedLength(block + start, block_size - start);
+                out->pages.emplace_back(reinterpret_cast<const char*>(block + start), length);
+                start += length + 1;
+            }
+            break;
+        }
+        case kBlockChars: {
+            if (block_size % kCharRecordSize != 0) {
+                return SetError(out_error, "chars block is not a whole number of records");
+            }
+            const std::size_t count = block_size / kCharRecordSize;
+            out->chars.reserve(out->chars.size() + count);
+            for (std::size_t i = 0; i < count; ++i) {
+                const unsigned char* record = block + i * kCharRecordSize;
+                FontChar glyph;
+                glyph.id = ReadU32(record);
+                glyph.x = ReadU16(record + 4);
+                glyph.y = ReadU16(record + 6);
+                glyph.width = ReadU16(record + 8);
+                glyph.height = ReadU16(record + 10);
+                glyph.xoffset = ReadS16(record + 12);
+                glyph.yoffset = ReadS16(record + 14);
+                glyph.xadvance = ReadS16(record + 16);
+                glyph.page = record[18];
+                out->chars.push_back(glyph);
+            }
+            break;
+        }
+        case kBlockKerning: {
+            if (block_size % kKerningRecordSize != 0) {
+                return SetError(out_error, "kerning block is not a whole number of records");
+            }
+            const std::size_t count = block_size / kKerningRecordSize;
+            out->kernings.reserve(out->kernings.size() + count);
+            for (std::size_t i = 0; i < count; ++i) {
+                const unsigned char* record = block + i * kKerningRecordSize;
+                FontKerning kerning;
+                kerning.first = ReadU32(record);
+                kerning.second = ReadU32(record + 4);
+                kerning.amount = ReadS16(record + 8);
+                out->kernings.push_back(kerning);
+            }
+            break;
+        }
+        default:
+            break;  // unknown blocks are skipped
+        }
+    }
+    if (out->chars.empty()) {
+        return SetError(out_error, "no chars block");
+    }
+    return true;
+}
+
+void AppendU8(std::vector<unsigned char>* blob, int value) {
+    blob->push_back(static_cast<unsigned char>(value));
+}
+
+void AppendU16(std::vector<unsigned char>* blob, int value) {
+    const std::uint16_t bits = static_cast<std::uint16_t>(value);
+    blob->push_back(static_cast<unsigned char>(bits & 0xff));
+    blob->push_back(static_cast<unsigned char>(bits >> 8));
+}
+
+void AppendU32(std::vector<unsigned char>* blob, std::uint32_t value) {
+    for (int shift = 0; shift < 32; shift += 8) {
+        blob->push_back(static_cast<unsigned char>((value >> shift) & 0xff));
+    }
+}
+
+void AppendBlockHeader(std::vector<unsigned char>* blob, BlockType type, std::size_t size) {
+    AppendU8(blob, type);
+    AppendU32(blob, static_cast<std::uint32_t>(size));
+}
+}  // namespace
+
+void FontDescriptor::Clear() {
+    face.clear();
+    size = 0;
+    line_height = 0;
+    base = 0;
+    scale_w = 0;
+    scale_h = 0;
+    pages.clear();
+    chars.clear();
+    kernings.clear();
+}
+
+bool ParseFont(const void* data, std::size_t size, FontDescriptor* out, std::string* out_error) {
+    out->Clear();
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    if (size >= kBinaryHeaderSize && std::memcmp(bytes, "BMF", 3) == 0) {
+        return ParseBinary(bytes, size, out, out_error);
+    }
+    const char* text = static_cast<const char*>(data);
+    return ParseXml(text, text + size, out, out_error);
+}
+
+void WriteFontBinary(const FontDescriptor& font, std::vector<unsigned char>* out_blob) {
+    std::size_t pages_size = 0;
+    for (const std::string& page : font.pages) {
+        pages_size += page.size() + 1;
+    }
+    std::vector<unsigned char>& blob = *out_blob;
+    blob.clear();
+    blob.reserve(kBinaryHeaderSize + 5 * kBlockHeaderSize + kInfoFixedSize + font.face.size() + 1 + kCommonSize +
+                 pages_size + font.chars.size() * kCharRecordSize + font.kernings.size() * kKerningRecordSize);
+    for (const char c : {'B', 'M', 'F'}) {
+        AppendU8(&blob, c);
+    }
+    AppendU8(&blob, kBinaryVersion);
+
+    AppendBlockHeader(&blob, kBlockInfo, kInfoFixedSize + font.face.size() + 1);
+    AppendU16(&blob, font.size);
+    AppendU8(&blob, 0);    // bitField
+    AppendU8(&blob, 0);    // charSet
+    AppendU16(&blob, 100); // stretchH
+    AppendU8(&blob, 1);    // aa
+    for (int i = 0; i < 4; ++i) {
+        AppendU8(&blob, 0);  // padding up/right/down/left
+    }
+    AppendU8(&blob, 0);  // spacing horizontal
+    AppendU8(&blob, 0);  // spacing vertical
+    AppendU8(&blob, 0);  // outline
+    blob.insert(blob.end(), font.face.begin(), font.face.end());
+    blob.push_back(0);
+
+    AppendBlockHeader(&blob, kBlockCommon, kCommonSize);
+    AppendU16(&blob, font.line_height);
+    AppendU16(&blob, font.base);
+    AppendU16(&blob, font.scale_w);
+    AppendU16(&blob, font.scale_h);
+    AppendU16(&blob, static_cast<int>(font.pages.size()));
+    for (int i = 0; i < 5; ++i) {
+        AppendU8(&blob, 0);  // bitField and channel modes
+    }
+
+    AppendBlockHeader(&blob, kBlockPages, pages_size);
+    for (const std::string& page : font.pages) {
+        blob.insert(blob.end(), page.begin(), page.end());
+        blob.push_back(0);
+    }
+
+    AppendBlockHeader(&blob, kBlockChars, font.chars.size() * kCharRecordSize);
+    for (const FontChar& glyph : font.chars) {
+        AppendU32(&blob, glyph.id);
+        AppendU16(&blob, glyph.x);
+        AppendU16(&blob, glyph.y);
+        AppendU16(&blob, glyph.width);
+        AppendU16(&blob, glyph.height);
+        AppendU16(&blob, glyph.xoffset);
+        AppendU16(&blob, glyph.yoffset);
+        AppendU16(&blob, glyph.xadvance);
+        AppendU8(&blob, glyph.page);
+        AppendU8(&blob, 15);  // chnl: all channels
+    }
+
+    if (!font.kernings.empty()) {
+        AppendBlockHeader(&blob, kBlockKerning, font.kernings.size() * kKerningRecordSize);
+        for (const FontKerning& kerning : font.kernings) {
+            AppendU32(&blob, kerning.first);
+            AppendU32(&blob, kerning.second);
+            AppendU16(&blob, kerning.amount);
+        }
+    }
+}
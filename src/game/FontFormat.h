@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// AngelCode BMFont descriptors. The game ships the XML export next to each
+// glyph page; tools/FontCompiler writes the same data as a binary v3 .fnt,
+// which loads without any text scanning. ParseFont accepts either.
+
+struct FontChar {
+    std::uint32_t id = 0;
+    int x = 0;
+    int y = 0;
+    int width = 0;
+    int height = 0;
+    int xoffset = 0;
+    int yoffset = 0;
+    int xadvance = 0;
+    int page = 0;
+};
+
+struct FontKerning {
+    std::uint32_t first = 0;
+    std::uint32_t second = 0;
+    int amount = 0;
+};
+
+struct FontDescriptor {
+    std::string face;
+    int size = 0;
+    int line_height = 0;
+    int base = 0;
+    int scale_w = 0;
+    int scale_h = 0;
+    std::vector<std::string> pages;
+    std::vector<FontChar> chars;
+    std::vector<FontKerning> kernings;
+
+    // Keeps vector capacity so a reused descriptor parses without allocating.
+    void Clear();
+};
+
+// Single pass over `data`, detecting the format from its first bytes. Vectors
+// are reserved from the `count` attributes / block sizes up front.
+bool ParseFont(const void* data, std::size_t size, FontDescriptor* out, std::string* out_error);
+
+// Serialises `font` as a binary BMFont v3 file.
+void WriteFontBinary(const FontDescriptor& font, std::vector<unsigned char>* out_blob);
@@ -4,6 +4,10 @@
 #include <SDL2/SDL_mixer.h>
 
 #include "Constants.h"
+#include "Profiler.h"
+#include "ProfilerOverlay.h"
+#include "Random.h"
+#include "RenderStats.h"
 #include "states/BootState.h"
 
 Game::Game() = default;
@@ -12,21 +16,70 @@ Game::~Game() {
     Shutdown();
 }
 
-bool Game::Init() {
-    if (SDL_Init(SDL_INIT_VIDEO | SDL_INIT_AUDIO) != 0) {
+bool Game::Init(const GameConfig& config) {
+    config_ = config;
+    if (!config_.replay_path.empty()) {
+        if (!replay_.LoadPlayback(config_.replay_path)) {
+            return false;
+        }
+        // The recording's tick rate and spawn settings, whatever the flags say.
+        const ReplayHeader& header = replay_.Header();
+        config_.sim_hz = static_cast<int>(header.sim_hz);
+        config_.spawn_multiplier = static_cast<int>(header.spawn_multiplier);
+        config_.particle_density = static_cast<int>(header.particle_density);
+    } else if (!config_.record_path.empty()) {
+        replay_.StartRecording(config_.record_path);
+    }
+    step_seconds_ = 1.0f / static_cast<float>(config_.sim_hz);
+    accumulator_ = 0.0;
+    render_alpha_ = 0.0f;
+
+    const Uint32 subsystems = config_.headless ? SDL_INIT_TIMER : (SDL_INIT_VIDEO | SDL_INIT_AUDIO);
+    if (SDL_Init(subsystems) != 0) {
         return false;
     }
+    SeedRandom(config_.seed != 0 ? config_.seed : static_cast<unsigned int>(SDL_GetPerformanceCounter()));
 
     if ((IMG_Init(IMG_INIT_PNG) & IMG_INIT_PNG) != IMG_INIT_PNG) {
         Shutdown();
         return false;
     }
 
-    if (Mix_OpenAudio(44100, MIX_DEFAULT_FORMAT, 2, 1024) < 0) {
+    if (!config_.headless) {
+        if (Mix_OpenAudio(constants::kAudioFrequency, MIX_DEFAULT_FORMAT, constants::kAudioChannels,
+                          constants::kAudioChunkSamples) < 0) {
+            Shutdown();
+            return false;
+        }
+        audio_open_ = true;
+    }
+
+    const bool renderer_ok = config_.headless ? CreateHeadlessRenderer() : CreateWindowRenderer();
+    if (!renderer_ok) {
+        Shutdown();
+        return false;
+    }
+
+    InitProfiler();
+
+    render_ctx_.Update();
+    if (!assets_.Init(renderer_, audio_open_)) {
         Shutdown();
         return false;
     }
+    if (config_.use_archive) {
+        assets_.MountArchive(kAssetArchivePath);
+    }
+    assets_.SetSkeletonBake(config_.skeleton_bake_hz, config_.skeleton_bake_lerp);
+    assets_.SetTextureBudget(static_cast<size_t>(config_.texture_budget_mb) * 1024 * 1024);
+    assets_.SetPrescaledEnabled(config_.prescaled_textures);
+    background_.SetEnabled(config_.cache_background);
 
+    ChangeState(std::make_unique<BootState>());
+    return true;
+}
+
+bool Game::CreateWindowRenderer() {
     window_ = SDL_CreateWindow(
         "Attack On Ball",
         SDL_WINDOWPOS_CENTERED,
@@ -36,48 +89,125 @@ bool Game::Init() {
         SDL_WINDOW_SHOWN);
 
     if (!window_) {
-        Shutdown();
         return false;
     }
 
-    renderer_ = SDL_CreateRenderer(window_, -1, SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC);
-    if (!renderer_) {
-        Shutdown();
-        return false;
+    Uint32 renderer_flags = SDL_RENDERER_ACCELERATED;
+    if (config_.pacing == FramePacing::kVsync) {
+        renderer_flags |= SDL_RENDERER_PRESENTVSYNC;
     }
+    renderer_ = SDL_CreateRenderer(window_, -1, renderer_flags);
+    return renderer_ != nullptr;
+}
 
-    render_ctx_.Update();
-    if (!assets_.Init(renderer_)) {
-        Shutdown();
+bool Game::CreateHeadlessRenderer() {
+    headless_surface_ = SDL_CreateRGBSurfaceWithFormat(0, constants::kScreenWidth, constants::kScreenHeight, 32,
+                                                       SDL_PIXELFORMAT_ARGB8888);
+    if (!headless_surface_) {
         return false;
     }
+    renderer_ = SDL_CreateSoftwareRenderer(headless_surface_);
+    return renderer_ != nullptr;
+}
 
-    ChangeState(std::make_unique<BootState>());
-    return true;
+void Game::InitProfiler() {
+#if defined(ENABLE_PROFILER)
+    profiler_overlay_ = config_.profile_overlay;
+    if (!config_.trace_path.empty() && !Profiler::Get().OpenTrace(config_.trace_path)) {
+        SDL_Log("could not open profiler trace '%s'", config_.trace_path.c_str());
+    }
+#else
+    if (config_.profile_overlay || !config_.trace_path.empty()) {
+        SDL_Log("--profile/--trace ignored: built without ENABLE_PROFILER");
+    }
+#endif
 }
 
 void Game::Run() {
-    Uint32 previous_ticks = SDL_GetTicks();
-    const float target_frame_time = 1.0f / static_cast<float>(constants::kTargetFps);
+    const double frequency = static_cast<double>(SDL_GetPerformanceFrequency());
+    Uint64 previous_counter = SDL_GetPerformanceCounter();
 
     while (running_) {
-        const Uint32 current_ticks = SDL_GetTicks();
-        float delta_seconds = static_cast<float>(current_ticks - previous_ticks) / 1000.0f;
-        if (delta_seconds > 0.05f) {
-            delta_seconds = 0.05f;
+        const Uint64 frame_start = SDL_GetPerformanceCounter();
+        const float frame_seconds = static_cast<float>(static_cast<double>(frame_start - previous_counter) / frequency);
+        previous_counter = frame_start;
+
+        PROFILE_BEGIN_FRAME();
+        {
+            PROFILE_SCOPE(ProfileZone::kProcessEvents);
+            ProcessEvents();
         }
-        previous_ticks = current_ticks;
+        Frame(frame_seconds);
+        PROFILE_END_FRAME();
+        WaitForNextFrame(frame_start);
+    }
+}
 
-        ProcessEvents();
+void Game::Frame(float delta_seconds) {
+    if (delta_seconds > constants::kMaxFrameSeconds) {
+        delta_seconds = constants::kMaxFrameSeconds;
+    }
+    accumulator_ += delta_seconds;
+    assets_.BeginFrame();
+    while (accumulator_ >= step_seconds_ && running_ && state_) {
+        Tick();
+        accumulator_ -= step_seconds_;
+    }
+    render_alpha_ = static_cast<float>(accumulator_ / step_seconds_);
 
-        if (state_) {
-            state_->Update(*this, delta_seconds);
-            state_->Render(*this);
+    if (!state_) {
+        return;
+    }
+    FrameRenderStats().Reset();
+    {
+        PROFILE_SCOPE(ProfileZone::kStateRender);
+        state_->Render(*this);
+#if defined(ENABLE_PROFILER)
+        if (profiler_overlay_) {
+            DrawProfilerOverlay(render_queue_, assets_);
         }
+#endif
+        render_queue_.Flush(renderer_);
+    }
+    PROFILE_SCOPE(ProfileZone::kPresent);
+    SDL_RenderPresent(renderer_);
+}
 
-        const Uint32 frame_time = SDL_GetTicks() - current_ticks;
-        if (frame_time < static_cast<Uint32>(target_frame_time * 1000.0f)) {
-            SDL_Delay(static_cast<Uint32>(target_frame_time * 1000.0f) - frame_time);
+void Game::Tick() {
+    if (replay_.Playing()) {
+        SDL_Event event;
+        while (replay_.NextEvent(&event)) {
+            DispatchEvent(event);
+        }
+    }
+    if (state_) {
+        PROFILE_SCOPE(ProfileZone::kStateUpdate);
+        state_->Update(*this, step_seconds_);
+    }
+    replay_.EndTick();
+    if (replay_.Finished()) {
+        running_ = false;
+    }
+}
+
+void Game::WaitForNextFrame(Uint64 frame_start) {
+    if (config_.pacing != FramePacing::kSleepSpin) {
+        return;
+    }
+    const Uint64 frequency = SDL_GetPerformanceFrequency();
+    const Uint64 frame_ticks = frequency / static_cast<Uint64>(config_.target_fps);
+    const Uint64 deadline = frame_start + frame_ticks;
+    // SDL_Delay only has millisecond granularity and often oversleeps, so sleep
+    // until ~2 ms before the deadline and spin the rest.
+    const Uint64 spin_margin = frequency / 500;
+    while (true) {
+        const Uint64 now = SDL_GetPerformanceCounter();
+        if (now >= deadline) {
+            return;
+        }
+        const Uint64 remaining = deadline - now;
+        if (remaining > spin_margin) {
+            SDL_Delay(static_cast<Uint32>((remaining - spin_margin) * 1000 / frequency));
         }
     }
 }
@@ -89,9 +219,27 @@ void Game::ProcessEvents() {
             running_ = false;
             return;
         }
-        if (state_) {
-            state_->HandleEvent(*this, event);
+#if defined(ENABLE_PROFILER)
+        if (event.type == SDL_KEYDOWN && event.key.keysym.sym == SDLK_F3 && !event.key.repeat) {
+            profiler_overlay_ = !profiler_overlay_;
+            continue;
+        }
+#endif
+        if (event.type == SDL_RENDER_TARGETS_RESET) {
+            background_.Invalidate();
+        }
+        if (replay_.Playing()) {
+            continue;  // the recording is the only input
         }
+        DispatchEvent(event);
+    }
+}
+
+void Game::DispatchEvent(const SDL_Event& event) {
+    // Before dispatching: the click that starts a run lands outside it.
+    replay_.RecordEvent(event);
+    if (state_) {
+        state_->HandleEvent(*this, event);
     }
 }
 
@@ -110,6 +258,10 @@ void Game::Shutdown() {
         state_->Exit(*this);
         state_.reset();
     }
+#if defined(ENABLE_PROFILER)
+    Profiler::Get().CloseTrace();
+#endif
+    background_.Shutdown();
     assets_.Shutdown();
     if (renderer_) {
         SDL_DestroyRenderer(renderer_);
@@ -119,7 +271,14 @@ void Game::Shutdown() {
         SDL_DestroyWindow(window_);
         window_ = nullptr;
     }
-    Mix_CloseAudio();
+    if (headless_surface_) {
+        SDL_FreeSurface(headless_surface_);
+        headless_surface_ = nullptr;
+    }
+    if (audio_open_) {
+        Mix_CloseAudio();
+        audio_open_ = false;
+    }
     IMG_Quit();
     SDL_Quit();
 }
@@ -4,7 +4,11 @@
 #include <memory>
 
 #include "Assets.h"
+#include "BackgroundCache.h"
+#include "GameConfig.h"
+#include "InputReplay.h"
 #include "RenderContext.h"
+#include "RenderQueue.h"
 #include "State.h"
 
 class Game {
@@ -12,8 +16,15 @@ public:
     Game();
     ~Game();
 
-    bool Init();
+    bool Init(const GameConfig& config = GameConfig{});
     void Run();
+    // Advances the simulation by `delta_seconds` of real time in fixed
+    // 1/sim_hz ticks, then renders once. Exposed for benchmarks that drive the
+    // game without the real-time loop.
+    void Frame(float delta_seconds);
+    // Runs exactly one fixed simulation step without rendering.
+    void Tick();
+    void DispatchEvent(const SDL_Event& event);
     void Shutdown();
 
     void ChangeState(std::unique_ptr<State> next_state);
@@ -21,19 +32,44 @@ public:
     SDL_Renderer* Renderer() { return renderer_; }
     SDL_Window* Window() { return window_; }
     Assets& GetAssets() { return assets_; }
+    BackgroundCache& Background() { return background_; }
+    // States queue their sprites here during Render; Frame flushes it.
+    RenderQueue& Queue() { return render_queue_; }
+    // --record / --replay; GameState runs feed and read it.
+    InputReplay& Replay() { return replay_; }
     const RenderContext& RenderCtx() const { return render_ctx_; }
     RenderContext& RenderCtx() { return render_ctx_; }
 
     void Quit() { running_ = false; }
 
+    const GameConfig& Config() const { return config_; }
+    float StepSeconds() const { return step_seconds_; }
+    // Fraction of a tick the renderer is ahead of the last simulated state;
+    // states blend previous and current positions by this amount.
+    float RenderAlpha() const { return render_alpha_; }
+
 private:
     void ProcessEvents();
+    void InitProfiler();
+    bool CreateWindowRenderer();
+    bool CreateHeadlessRenderer();
+    void WaitForNextFrame(Uint64 frame_start);
 
     SDL_Window* window_ = nullptr;
     SDL_Renderer* renderer_ = nullptr;
+    SDL_Surface* headless_surface_ = nullptr;
+    bool audio_open_ = false;
     bool running_ = true;
+    GameConfig config_{};
+    float step_seconds_ = 1.0f / static_cast<float>(constants::kSimHz);
+    double accumulator_ = 0.0;
+    float render_alpha_ = 0.0f;
+    bool profiler_overlay_ = false;
 
     Assets assets_{};
+    BackgroundCache background_;
+    RenderQueue render_queue_;
     RenderContext render_ctx_{};
+    InputReplay replay_;
     std::unique_ptr<State> state_;
 };
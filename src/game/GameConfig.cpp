@@ -0,0 +1,106 @@
+#include "GameConfig.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+namespace {
+const char* MatchFlag(const char* arg, const char* flag) {
+    const size_t length = std::strlen(flag);
+    if (std::strncmp(arg, flag, length) != 0) {
+        return nullptr;
+    }
+    return arg + length;
+}
+
+bool ParseSeed(const char* text, unsigned int* out_value) {
+    char* end = nullptr;
+    const unsigned long value = std::strtoul(text, &end, 10);
+    if (end == text || *end != '\0') {
+        return false;
+    }
+    *out_value = static_cast<unsigned int>(value);
+    return true;
+}
+
+bool ParsePositiveInt(const char* text, int* out_value) {
+    char* end = nullptr;
+    const long value = std::strtol(text, &end, 10);
+    if (end == text || *end != '\0' || value <= 0 || value > 10000) {
+        return false;
+    }
+    *out_value = static_cast<int>(value);
+    return true;
+}
+
+void PrintUsage(const char* program) {
+    std::fprintf(stderr,
+                 "usage: %s [--pacing=vsync|sleep|uncapped] [--sim-hz=N] [--fps=N] [--seed=N] [--profile]\n"
+                 "          [--trace=file.csv] [--skeleton-bake=HZ] [--skeleton-bake-nearest] [--sync-preload]\n"
+                 "          [--loose-assets] [--texture-budget=MB] [--full-res-textures] [--no-background-cache]\n"
+                 "          [--stress=N] [--particle-density=N] [--record=FILE | --replay=FILE]\n",
+                 program);
+}
+}
+
+bool ParseGameConfig(int argc, char* argv[], GameConfig* out_config) {
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        const char* value = nullptr;
+        bool ok = true;
+        if ((value = MatchFlag(arg, "--pacing="))) {
+            if (std::strcmp(value, "vsync") == 0) {
+                out_config->pacing = FramePacing::kVsync;
+            } else if (std::strcmp(value, "sleep") == 0) {
+                out_config->pacing = FramePacing::kSleepSpin;
+            } else if (std::strcmp(value, "uncapped") == 0) {
+                out_config->pacing = FramePacing::kUncapped;
+            } else {
+                ok = false;
+            }
+        } else if ((value = MatchFlag(arg, "--sim-hz="))) {
+            ok = ParsePositiveInt(value, &out_config->sim_hz);
+        } else if ((value = MatchFlag(arg, "--fps="))) {
+            ok = ParsePositiveInt(value, &out_config->target_fps);
+        } else if ((value = MatchFlag(arg, "--seed="))) {
+            ok = ParseSeed(value, &out_config->seed);
+        } else if (std::strcmp(arg, "--profile") == 0) {
+            out_config->profile_overlay = true;
+        } else if ((value = MatchFlag(arg, "--skeleton-bake="))) {
+            ok = ParsePositiveInt(value, &out_config->skeleton_bake_hz);
+        } else if (std::strcmp(arg, "--skeleton-bake-nearest") == 0) {
+            out_config->skeleton_bake_lerp = false;
+        } else if (std::strcmp(arg, "--sync-preload") == 0) {
+            out_config->async_preload = false;
+        } else if (std::strcmp(arg, "--loose-assets") == 0) {
+            out_config->use_archive = false;
+        } else if ((value = MatchFlag(arg, "--texture-budget="))) {
+            ok = ParsePositiveInt(value, &out_config->texture_budget_mb);
+        } else if (std::strcmp(arg, "--full-res-textures") == 0) {
+            out_config->prescaled_textures = false;
+        } else if (std::strcmp(arg, "--no-background-cache") == 0) {
+            out_config->cache_background = false;
+        } else if ((value = MatchFlag(arg, "--stress="))) {
+            ok = ParsePositiveInt(value, &out_config->spawn_multiplier);
+        } else if ((value = MatchFlag(arg, "--particle-density="))) {
+            ok = ParsePositiveInt(value, &out_config->particle_density);
+        } else if ((value = MatchFlag(arg, "--trace="))) {
+            out_config->trace_path = value;
+            ok = *value != '\0';
+        } else if ((value = MatchFlag(arg, "--record="))) {
+            out_config->record_path = value;
+            ok = *value != '\0' && out_config->replay_path.empty();
+        } else if ((value = MatchFlag(arg, "--replay="))) {
+            out_config->replay_path = value;
+            ok = *value != '\0' && out_config->record_path.empty();
+        } else {
+            ok = false;
+        }
+        if (!ok) {
+            std::fprintf(stderr, "invalid argument '%s'\n", arg);
+            PrintUsage(argv[0]);
+            return false;
+        }
+    }
+    return true;
+}
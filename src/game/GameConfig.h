@@ -0,0 +1,59 @@
+#pragma once
+
+#include <string>
+
+#include "Constants.h"
+
+// How Game::Run waits between frames.
+enum class FramePacing {
+    kVsync,      // present blocks on vblank; no sleeping
+    kSleepSpin,  // no vsync; SDL_Delay most of the frame, spin the remainder
+    kUncapped    // no vsync, no waiting
+};
+
+struct GameConfig {
+    FramePacing pacing = FramePacing::kVsync;
+    int sim_hz = constants::kSimHz;
+    int target_fps = constants::kTargetFps;
+    // Gameplay RNG seed; 0 picks one from the clock.
+    unsigned int seed = 0;
+    // No window or audio device: a software renderer on an offscreen surface
+    // and a mixer that never opens (sounds load as silent no-ops).
+    bool headless = false;
+    // Profiler output; both need a build with ENABLE_PROFILER. The overlay can
+    // also be toggled with F3.
+    bool profile_overlay = false;
+    std::string trace_path;
+    // Bake skeleton animations at this rate on load (0 = evaluate bones live),
+    // blending neighbouring samples unless nearest is requested.
+    int skeleton_bake_hz = 0;
+    bool skeleton_bake_lerp = true;
+    // Decode assets on worker threads behind a progress bar. Headless runs
+    // always load synchronously during Init.
+    bool async_preload = true;
+    // Read assets from the packed archive when it exists; --loose-assets reads
+    // assets/ directly while iterating on files.
+    bool use_archive = true;
+    // Resident texture budget in MB (0 = unlimited); see Assets::SetTextureBudget.
+    int texture_budget_mb = 0;
+    // Use output-resolution copies of the full-screen layers when
+    // pack_assets.sh made them; --full-res-textures loads the design-size PNGs.
+    bool prescaled_textures = true;
+    // Keep Bg and the land strip composited in a render target (see
+    // BackgroundCache); --no-background-cache draws both every frame.
+    bool cache_background = true;
+    // Balls and number items spawned per spawner tick; --stress=N raises it
+    // to push the entity pools into the thousands.
+    int spawn_multiplier = 1;
+    // Multiplies every particle emitter's burst (death blood and body parts).
+    int particle_density = 1;
+    // Input replay (see InputReplay): --record=FILE saves each GameState run
+    // as it ends; --replay=FILE starts straight into the recorded run, plays
+    // it back in place of live input and quits when it ends.
+    std::string record_path;
+    std::string replay_path;
+};
+
+// Parses command line flags into `out_config`. Returns false (after printing
+// usage) on an unknown or malformed flag.
+bool ParseGameConfig(int argc, char* argv[], GameConfig* out_config);
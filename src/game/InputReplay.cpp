@@ -0,0 +1,172 @@
+#include "InputReplay.h"
+
+#include <cstdio>
+#include <cstring>
+
+#include "GameConfig.h"
+#include "MappedFile.h"
+#include "Random.h"
+
+void InputReplay::StartRecording(const std::string& path) {
+    mode_ = Mode::kRecord;
+    path_ = path;
+}
+
+bool InputReplay::LoadPlayback(const std::string& path) {
+    MappedFile file;
+    if (!file.Open(path)) {
+        SDL_Log("could not open replay '%s'", path.c_str());
+        return false;
+    }
+    if (file.Size() < sizeof(ReplayHeader)) {
+        SDL_Log("replay '%s' is truncated", path.c_str());
+        return false;
+    }
+    ReplayHeader header{};
+    std::memcpy(&header, file.Data(), sizeof(header));
+    if (header.magic != kReplayMagic || header.version != kReplayVersion) {
+        SDL_Log("'%s' is not a version %u replay", path.c_str(), kReplayVersion);
+        return false;
+    }
+    if (header.sim_hz == 0 || header.spawn_multiplier == 0 || header.particle_density == 0 ||
+        file.Size() != sizeof(ReplayHeader) + static_cast<std::size_t>(header.record_count) * sizeof(ReplayRecord)) {
+        SDL_Log("replay '%s' is malformed", path.c_str());
+        return false;
+    }
+    records_.resize(header.record_count);
+    if (!records_.empty()) {
+        std::memcpy(records_.data(), file.Data() + sizeof(ReplayHeader), records_.size() * sizeof(ReplayRecord));
+    }
+    header_ = header;
+    mode_ = Mode::kPlay;
+    path_ = path;
+    return true;
+}
+
+void InputReplay::BeginRun(const GameConfig& config, int best_score, int land_index) {
+    tick_ = 0;
+    keys_ = 0;
+    cursor_ = 0;
+    if (mode_ == Mode::kPlay) {
+        // One run per file; a second GameState plays live.
+        if (in_run_ || finished_) {
+            mode_ = Mode::kOff;
+            return;
+        }
+        in_run_ = true;
+        SeedRandom(header_.seed);
+        return;
+    }
+    if (mode_ != Mode::kRecord) {
+        return;
+    }
+    in_run_ = true;
+    records_.clear();
+    header_ = ReplayHeader{};
+    header_.magic = kReplayMagic;
+    header_.version = kReplayVersion;
+    // Drawn from the gameplay RNG, so --seed still picks the whole session.
+    header_.seed = static_cast<std::uint32_t>(RandomInt(1, 0x7fffffff));
+    header_.sim_hz = static_cast<std::uint32_t>(config.sim_hz);
+    header_.spawn_multiplier = static_cast<std::uint32_t>(config.spawn_multiplier);
+    header_.particle_density = static_cast<std::uint32_t>(config.particle_density);
+    header_.best_score = best_score;
+    header_.land_index = land_index;
+    SeedRandom(header_.seed);
+}
+
+void InputReplay::EndRun(int final_score) {
+    if (!in_run_) {
+        return;
+    }
+    in_run_ = false;
+    if (mode_ == Mode::kRecord) {
+        header_.tick_count = tick_;
+        header_.record_count = static_cast<std::uint32_t>(records_.size());
+        header_.final_score = final_score;
+        if (!WriteFile()) {
+            SDL_Log("could not write replay '%s'", path_.c_str());
+        }
+        return;
+    }
+    finished_ = true;
+    matched_ = tick_ == header_.tick_count && final_score == header_.final_score;
+    if (matched_) {
+        SDL_Log("replay matched: %u ticks, score %d", tick_, final_score);
+    } else {
+        SDL_Log("replay diverged: %u ticks, score %d (recorded %u ticks, score %d)", tick_, final_score,
+                header_.tick_count, header_.final_score);
+    }
+}
+
+bool InputReplay::NextEvent(SDL_Event* out_event) {
+    if (mode_ != Mode::kPlay || !in_run_) {
+        return false;
+    }
+    while (cursor_ < records_.size() && records_[cursor_].tick <= tick_) {
+        const ReplayRecord& record = records_[cursor_++];
+        if (record.kind == ReplayRecordKind::kKeys) {
+            keys_ = record.keys;
+            continue;
+        }
+        *out_event = SDL_Event{};
+        out_event->type = record.kind == ReplayRecordKind::kMouseDown ? SDL_MOUSEBUTTONDOWN : SDL_MOUSEBUTTONUP;
+        out_event->button.button = SDL_BUTTON_LEFT;
+        out_event->button.x = record.x;
+        out_event->button.y = record.y;
+        return true;
+    }
+    return false;
+}
+
+void InputReplay::EndTick() {
+    if (!in_run_) {
+        return;
+    }
+    tick_++;
+    if (mode_ == Mode::kPlay && tick_ >= header_.tick_count) {
+        finished_ = true;
+    }
+}
+
+void InputReplay::RecordEvent(const SDL_Event& event) {
+    if (mode_ != Mode::kRecord || !in_run_) {
+        return;
+    }
+    if (event.type != SDL_MOUSEBUTTONDOWN && event.type != SDL_MOUSEBUTTONUP) {
+        return;
+    }
+    ReplayRecord record{};
+    record.tick = tick_;
+    record.kind = event.type == SDL_MOUSEBUTTONDOWN ? ReplayRecordKind::kMouseDown : ReplayRecordKind::kMouseUp;
+    record.x = static_cast<std::int16_t>(event.button.x);
+    record.y = static_cast<std::int16_t>(event.button.y);
+    records_.push_back(record);
+}
+
+std::uint8_t InputReplay::Keys(std::uint8_t live) {
+    if (mode_ == Mode::kPlay && in_run_) {
+        return keys_;
+    }
+    if (mode_ == Mode::kRecord && in_run_ && live != keys_) {
+        ReplayRecord record{};
+        record.tick = tick_;
+        record.kind = ReplayRecordKind::kKeys;
+        record.keys = live;
+        records_.push_back(record);
+        keys_ = live;
+    }
+    return live;
+}
+
+bool InputReplay::WriteFile() const {
+    std::FILE* file = std::fopen(path_.c_str(), "wb");
+    if (!file) {
+        return false;
+    }
+    bool ok = std::fwrite(&header_, sizeof(header_), 1, file) == 1;
+    if (ok && !records_.empty()) {
+        ok = std::fwrite(records_.data(), sizeof(ReplayRecord), records_.size(), file) == records_.size();
+    }
+    return std::fclose(file) == 0 && ok;
+}
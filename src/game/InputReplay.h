@@ -0,0 +1,100 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+struct GameConfig;
+
+// Replay file: a header, then `record_count` records in tick order. Values are
+// stored little-endian.
+
+constexpr std::uint32_t kReplayMagic = 0x594c5052;  // "RPLY"
+constexpr std::uint32_t kReplayVersion = 1;
+
+// Everything a run's outcome depends on besides its input.
+struct ReplayHeader {
+    std::uint32_t magic;
+    std::uint32_t version;
+    std::uint32_t seed;
+    std::uint32_t sim_hz;
+    std::uint32_t spawn_multiplier;
+    std::uint32_t particle_density;
+    std::int32_t best_score;
+    std::int32_t land_index;
+    std::uint32_t tick_count;
+    std::uint32_t record_count;
+    std::int32_t final_score;  // gauge count when the run ended
+};
+
+enum class ReplayRecordKind : std::uint8_t { kKeys, kMouseDown, kMouseUp };
+
+// Held movement keys, as GameState::HandleInput reads them.
+constexpr std::uint8_t kReplayKeyLeft = 1u << 0;
+constexpr std::uint8_t kReplayKeyRight = 1u << 1;
+
+// One input change, applied before tick `tick` of the run.
+struct ReplayRecord {
+    std::uint32_t tick;
+    ReplayRecordKind kind;
+    std::uint8_t keys;  // kKeys: kReplayKey* bits held from this tick on
+    std::int16_t x;     // mouse events: window position
+    std::int16_t y;
+    std::uint16_t padding;
+};
+
+// Records the input one GameState run sees, or plays a recording back in its
+// place. A run is bracketed by BeginRun/EndRun (GameState::Enter/Exit) and
+// counts ticks from its first Update. Only what the run reads is kept: the
+// movement keys, sampled once per tick and stored when they change, and the
+// mouse button events dispatched to it. With the seed and the config values
+// in the header that is enough to repeat the run tick for tick.
+//
+// Recording writes the file when the run ends, so it holds the most recent
+// run. Playback stops after the recorded tick count and checks the final score
+// against the recording.
+class InputReplay {
+public:
+    // Only one of the two, once, from Game::Init.
+    void StartRecording(const std::string& path);
+    bool LoadPlayback(const std::string& path);
+
+    bool Recording() const { return mode_ == Mode::kRecord; }
+    bool Playing() const { return mode_ == Mode::kPlay; }
+    // Playback has run out of ticks or the run has ended.
+    bool Finished() const { return finished_; }
+    // Playback ended on the recorded tick with the recorded score.
+    bool Matched() const { return matched_; }
+    const ReplayHeader& Header() const { return header_; }
+
+    // Reseeds the gameplay RNG: with a fresh seed that is written down when
+    // recording, with the recorded seed when playing.
+    void BeginRun(const GameConfig& config, int best_score, int land_index);
+    void EndRun(int final_score);
+
+    // Playback: the mouse events due before the current tick, one per call,
+    // until it returns false. Applies recorded key changes on the way.
+    bool NextEvent(SDL_Event* out_event);
+    void EndTick();
+
+    void RecordEvent(const SDL_Event& event);
+    // The keys the run sees this tick: `live` when not playing back.
+    std::uint8_t Keys(std::uint8_t live);
+
+private:
+    enum class Mode { kOff, kRecord, kPlay };
+
+    Mode mode_ = Mode::kOff;
+    std::string path_;
+    ReplayHeader header_{};
+    std::vector<ReplayRecord> records_;
+    std::size_t cursor_ = 0;
+    std::uint32_t tick_ = 0;
+    std::uint8_t keys_ = 0;
+    bool in_run_ = false;
+    bool finished_ = false;
+    bool matched_ = false;
+
+    bool WriteFile() const;
+};
@@ -0,0 +1,207 @@
+#include "ParticleSystem.h"
+
+#include "Assets.h"
+#include "MathUtils.h"
+#include "Random.h"
+#include "RenderHelpers.h"
+
+#if !defined(PARTICLES_SCALAR)
+#if defined(__SSE2__) || defined(_M_X64)
+#define PARTICLES_USE_SSE2 1
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define PARTICLES_USE_NEON 1
+#include <arm_neon.h>
+#endif
+#endif
+
+namespace {
+constexpr EmitterDef kEmitters[] = {
+#define PARTICLE_DEF(name, count, vel_x_min, vel_x_max, vel_y_min, vel_y_max, life_min, life_max, scale_min, \
+                     scale_max, gravity, texture, frames)                                                  \
+    {count, vel_x_min, vel_x_max, vel_y_min, vel_y_max, life_min, life_max, scale_min, scale_max, gravity, texture, frames},
+    PARTICLE_EMITTERS(PARTICLE_DEF)
+#undef PARTICLE_DEF
+};
+
+// Four-lane helpers so the kernel body is shared between SSE2 and NEON.
+// Loads and stores are unaligned: compaction writes at any index.
+#if defined(PARTICLES_USE_SSE2)
+using Vec4 = __m128;
+inline Vec4 Load(const float* p) { return _mm_loadu_ps(p); }
+inline void Store(float* p, Vec4 v) { _mm_storeu_ps(p, v); }
+inline Vec4 Splat(float value) { return _mm_set1_ps(value); }
+inline Vec4 Add(Vec4 a, Vec4 b) { return _mm_add_ps(a, b); }
+inline Vec4 Sub(Vec4 a, Vec4 b) { return _mm_sub_ps(a, b); }
+inline Vec4 Mul(Vec4 a, Vec4 b) { return _mm_mul_ps(a, b); }
+inline bool AnyNonPositive(Vec4 v) { return _mm_movemask_ps(_mm_cmple_ps(v, _mm_setzero_ps())) != 0; }
+#elif defined(PARTICLES_USE_NEON)
+using Vec4 = float32x4_t;
+inline Vec4 Load(const float* p) { return vld1q_f32(p); }
+inline void Store(float* p, Vec4 v) { vst1q_f32(p, v); }
+inline Vec4 Splat(float value) { return vdupq_n_f32(value); }
+inline Vec4 Add(Vec4 a, Vec4 b) { return vaddq_f32(a, b); }
+inline Vec4 Sub(Vec4 a, Vec4 b) { return vsubq_f32(a, b); }
+inline Vec4 Mul(Vec4 a, Vec4 b) { return vmulq_f32(a, b); }
+inline bool AnyNonPositive(Vec4 v) {
+    // ARMv7 has no horizontal max; fold the lane masks down to one word.
+    const uint32x4_t mask = vcleq_f32(v, vdupq_n_f32(0.0f));
+    const uint32x2_t folded = vorr_u32(vget_low_u32(mask), vget_high_u32(mask));
+    return (vget_lane_u32(folded, 0) | vget_lane_u32(folded, 1)) != 0;
+}
+#endif
+}
+
+const EmitterDef& Emitter(EmitterId id) {
+    return kEmitters[static_cast<int>(id)];
+}
+
+ParticleSystem::ParticleSystem()
+    : pos_x_(kCapacity),
+      pos_y_(kCapacity),
+      prev_x_(kCapacity),
+      prev_y_(kCapacity),
+      vel_x_(kCapacity),
+      vel_y_(kCapacity),
+      life_(kCapacity),
+      gravity_(kCapacity),
+      scale_(kCapacity),
+      texture_(kCapacity) {}
+
+void ParticleSystem::Emit(EmitterId id, float x, float y, int density) {
+    const EmitterDef& def = Emitter(id);
+    const int total = def.count * density;
+    for (int n = 0; n < total && count_ < kCapacity; ++n) {
+        const int i = count_++;
+        pos_x_[i] = x;
+        pos_y_[i] = y;
+        prev_x_[i] = x;
+        prev_y_[i] = y;
+        vel_x_[i] = RandomRange(def.vel_x_min, def.vel_x_max);
+        vel_y_[i] = RandomRange(def.vel_y_min, def.vel_y_max);
+        life_[i] = RandomRange(def.life_min, def.life_max);
+        gravity_[i] = def.gravity;
+        scale_[i] = def.scale_min < def.scale_max ? RandomRange(def.scale_min, def.scale_max) : def.scale_min;
+        const TextureId texture = def.frames > 1 ? TextureFrame(def.texture, RandomInt(0, def.frames - 1)) : def.texture;
+        texture_[i] = static_cast<std::uint16_t>(texture);
+    }
+}
+
+void ParticleSystem::Update(float delta_seconds) {
+    UpdateSimd(delta_seconds);
+}
+
+void ParticleSystem::UpdateScalar(float delta_seconds) {
+    int write = 0;
+    for (int i = 0; i < count_; ++i) {
+        Step(i, delta_seconds);
+        if (life_[i] > 0.0f) {
+            Move(write++, i);
+        }
+    }
+    count_ = write;
+}
+
+void ParticleSystem::UpdateSimd(float delta_seconds) {
+#if defined(PARTICLES_USE_SSE2) || defined(PARTICLES_USE_NEON)
+    const Vec4 step = Splat(delta_seconds);
+    const int block_end = count_ & ~3;
+    int write = 0;
+    int i = 0;
+    for (; i < block_end; i += 4) {
+        const Vec4 x = Load(&pos_x_[i]);
+        const Vec4 y = Load(&pos_y_[i]);
+        const Vec4 vel_y = Add(Load(&vel_y_[i]), Mul(Load(&gravity_[i]), step));
+        const Vec4 new_x = Add(x, Mul(Load(&vel_x_[i]), step));
+        const Vec4 new_y = Add(y, Mul(vel_y, step));
+        const Vec4 life = Sub(Load(&life_[i]), step);
+
+        if (!AnyNonPositive(life)) {
+            // Common case: the whole block survives and moves down as one.
+            // Every index written here is below i + 4, so nothing unread is
+            // overwritten.
+            Store(&prev_x_[write], x);
+            Store(&prev_y_[write], y);
+            Store(&pos_x_[write], new_x);
+            Store(&pos_y_[write], new_y);
+            Store(&vel_y_[write], vel_y);
+            Store(&life_[write], life);
+            if (write != i) {
+                for (int lane = 0; lane < 4; ++lane) {
+                    vel_x_[write + lane] = vel_x_[i + lane];
+                    gravity_[write + lane] = gravity_[i + lane];
+                    scale_[write + lane] = scale_[i + lane];
+                    texture_[write + lane] = texture_[i + lane];
+                }
+            }
+            write += 4;
+            continue;
+        }
+
+        Store(&prev_x_[i], x);
+        Store(&prev_y_[i], y);
+        Store(&pos_x_[i], new_x);
+        Store(&pos_y_[i], new_y);
+        Store(&vel_y_[i], vel_y);
+        Store(&life_[i], life);
+        for (int lane = i; lane < i + 4; ++lane) {
+            if (life_[lane] > 0.0f) {
+                Move(write++, lane);
+            }
+        }
+    }
+    for (; i < count_; ++i) {
+        Step(i, delta_seconds);
+        if (life_[i] > 0.0f) {
+            Move(write++, i);
+        }
+    }
+    count_ = write;
+#else
+    UpdateScalar(delta_seconds);
+#endif
+}
+
+const char* ParticleSystem::SimdKernelName() {
+#if defined(PARTICLES_USE_SSE2)
+    return "sse2";
+#elif defined(PARTICLES_USE_NEON)
+    return "neon";
+#else
+    return "scalar";
+#endif
+}
+
+void ParticleSystem::Draw(RenderQueue& queue, const RenderContext& ctx, const Assets& assets, float alpha) const {
+    for (int i = 0; i < count_; ++i) {
+        const float x = Lerp(prev_x_[i], pos_x_[i], alpha);
+        const float y = Lerp(prev_y_[i], pos_y_[i], alpha);
+        const TextureAsset& asset = assets.GetTexture(static_cast<TextureId>(texture_[i]));
+        DrawTextureCentered(queue, ctx, asset, x, y, scale_[i], scale_[i], SDL_Color{255, 255, 255, 255});
+    }
+}
+
+void ParticleSystem::Step(int i, float delta_seconds) {
+    prev_x_[i] = pos_x_[i];
+    prev_y_[i] = pos_y_[i];
+    vel_y_[i] += gravity_[i] * delta_seconds;
+    pos_x_[i] += vel_x_[i] * delta_seconds;
+    pos_y_[i] += vel_y_[i] * delta_seconds;
+    life_[i] -= delta_seconds;
+}
+
+void ParticleSystem::Move(int to, int from) {
+    if (to == from) {
+        return;
+    }
+    pos_x_[to] = pos_x_[from];
+    pos_y_[to] = pos_y_[from];
+    prev_x_[to] = prev_x_[from];
+    prev_y_[to] = prev_y_[from];
+    vel_x_[to] = vel_x_[from];
+    vel_y_[to] = vel_y_[from];
+    life_[to] = life_[from];
+    gravity_[to] = gravity_[from];
+    scale_[to] = scale_[from];
+    texture_[to] = texture_[from];
+}
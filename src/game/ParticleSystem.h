@@ -0,0 +1,87 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "AssetIds.h"
+#include "RenderContext.h"
+#include "RenderQueue.h"
+
+class Assets;
+
+// Emitters: ID, particles per burst, launch velocity range (design units/s),
+// lifetime range (s), scale range, gravity (units/s^2), and the textures a
+// particle picks from (first frame + frame count, see TextureFrame).
+#define PARTICLE_EMITTERS(X)                                                                                     \
+    X(Blood, 50, -300.0f, 300.0f, -1000.0f, 0.0f, 0.8f, 1.5f, 0.2f, 1.5f, 950.0f, TextureId::kBlood, 1)          \
+    X(DeadParts, 8, -800.0f, 800.0f, -1000.0f, 0.0f, 1.0f, 2.0f, 1.0f, 1.0f, 950.0f, TextureId::kDeadParts0, 8)
+
+enum class EmitterId : int {
+#define PARTICLE_ID(name, ...) k##name,
+    PARTICLE_EMITTERS(PARTICLE_ID)
+#undef PARTICLE_ID
+    kCount
+};
+
+struct EmitterDef {
+    int count;
+    float vel_x_min;
+    float vel_x_max;
+    float vel_y_min;
+    float vel_y_max;
+    float life_min;
+    float life_max;
+    float scale_min;
+    float scale_max;
+    float gravity;
+    TextureId texture;
+    int frames;
+};
+
+const EmitterDef& Emitter(EmitterId id);
+
+// Fixed-capacity particle pool in structure-of-arrays form. Update runs one
+// integrate-and-cull pass: it saves the previous position (for interpolated
+// drawing), applies gravity and velocity, ages the particle and compacts the
+// survivors in place, keeping their order. The pass uses SSE2 or NEON four
+// particles at a time when the compiler targets them (PARTICLES_SCALAR forces
+// the plain loop); both kernels stay public for bench/ParticleBench.
+class ParticleSystem {
+public:
+    static constexpr int kCapacity = 8192;
+
+    ParticleSystem();
+
+    // Spawns `Emitter(id).count * density` particles at (x, y), drawing every
+    // random value from the gameplay RNG. Particles past capacity are dropped.
+    void Emit(EmitterId id, float x, float y, int density = 1);
+    void Clear() { count_ = 0; }
+    void Update(float delta_seconds);
+    void Draw(RenderQueue& queue, const RenderContext& ctx, const Assets& assets, float alpha) const;
+
+    int Count() const { return count_; }
+
+    void UpdateScalar(float delta_seconds);
+    void UpdateSimd(float delta_seconds);
+    // "sse2", "neon" or "scalar": what UpdateSimd actually runs.
+    static const char* SimdKernelName();
+
+private:
+    // Hot: read and written by the kernel every tick.
+    std::vector<float> pos_x_;
+    std::vector<float> pos_y_;
+    std::vector<float> prev_x_;
+    std::vector<float> prev_y_;
+    std::vector<float> vel_x_;
+    std::vector<float> vel_y_;
+    std::vector<float> life_;
+    std::vector<float> gravity_;
+    // Cold: only moved when compaction shifts a particle, read when drawing.
+    std::vector<float> scale_;
+    std::vector<std::uint16_t> texture_;
+    int count_ = 0;
+
+    // Scalar integrate of one particle; the kernels' shared tail.
+    void Step(int i, float delta_seconds);
+    void Move(int to, int from);
+};
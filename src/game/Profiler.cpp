@@ -0,0 +1,106 @@
+#include "Profiler.h"
+
+namespace {
+const char* kZoneNames[kProfileZoneCount] = {
+    "UpdateHero",
+    "UpdateBalls",
+    "UpdateNumbers",
+    "UpdateParticles",
+    "CheckCollisions",
+    "Spawners",
+    "ProcessEvents",
+    "StateUpdate",
+    "StateRender",
+    "Present",
+    "RenderBackground",
+    "RenderBalls",
+    "RenderNumbers",
+    "RenderStickman",
+    "RenderParticles",
+    "RenderHud",
+};
+
+// Weight of the newest frame in the smoothed averages (~30 frame window).
+constexpr double kSmoothing = 1.0 / 30.0;
+
+void Smooth(double* average, double sample, bool first) {
+    *average = first ? sample : *average + (sample - *average) * kSmoothing;
+}
+}
+
+Profiler& Profiler::Get() {
+    static Profiler profiler;
+    return profiler;
+}
+
+Profiler::~Profiler() {
+    CloseTrace();
+}
+
+const char* Profiler::ZoneName(ProfileZone zone) {
+    return kZoneNames[static_cast<int>(zone)];
+}
+
+void Profiler::Reset() {
+    for (int i = 0; i < kProfileZoneCount; ++i) {
+        total_ticks_[i] = 0;
+        calls_[i] = 0;
+        smoothed_us_[i] = 0.0;
+    }
+    current_ = ProfileFrame{};
+    last_ = ProfileFrame{};
+    frame_count_ = 0;
+    smoothed_frame_us_ = 0.0;
+}
+
+void Profiler::BeginFrame() {
+    current_ = ProfileFrame{};
+    frame_start_ = SDL_GetPerformanceCounter();
+}
+
+void Profiler::EndFrame() {
+    current_.frame_ticks = SDL_GetPerformanceCounter() - frame_start_;
+    last_ = current_;
+
+    const double micros_per_tick = 1000000.0 / static_cast<double>(SDL_GetPerformanceFrequency());
+    const bool first = frame_count_ == 0;
+    for (int i = 0; i < kProfileZoneCount; ++i) {
+        Smooth(&smoothed_us_[i], static_cast<double>(last_.zone_ticks[i]) * micros_per_tick, first);
+    }
+    Smooth(&smoothed_frame_us_, static_cast<double>(last_.frame_ticks) * micros_per_tick, first);
+    frame_count_++;
+
+    if (trace_) {
+        WriteTraceRow(micros_per_tick);
+    }
+}
+
+bool Profiler::OpenTrace(const std::string& path) {
+    CloseTrace();
+    trace_ = std::fopen(path.c_str(), "w");
+    if (!trace_) {
+        return false;
+    }
+    std::fputs("frame,frame_us", trace_);
+    for (int i = 0; i < kProfileZoneCount; ++i) {
+        std::fprintf(trace_, ",%s_us", kZoneNames[i]);
+    }
+    std::fputc('\n', trace_);
+    return true;
+}
+
+void Profiler::CloseTrace() {
+    if (trace_) {
+        std::fclose(trace_);
+        trace_ = nullptr;
+    }
+}
+
+void Profiler::WriteTraceRow(double micros_per_tick) {
+    std::fprintf(trace_, "%llu,%.1f", static_cast<unsigned long long>(frame_count_ - 1),
+                 static_cast<double>(last_.frame_ticks) * micros_per_tick);
+    for (int i = 0; i < kProfileZoneCount; ++i) {
+        std::fprintf(trace_, ",%.1f", static_cast<double>(last_.zone_ticks[i]) * micros_per_tick);
+    }
+    std::fputc('\n', trace_);
+}
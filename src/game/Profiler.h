@@ -0,0 +1,114 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+#include <cstdio>
+#include <string>
+
+// Named timing zones. Add new zones before kCount and give them a name in
+// Profiler.cpp. Zones may nest (the render layers run inside kStateRender).
+enum class ProfileZone : int {
+    kUpdateHero,
+    kUpdateBalls,
+    kUpdateNumbers,
+    kUpdateParticles,
+    kCollisions,
+    kSpawners,
+    kProcessEvents,
+    kStateUpdate,
+    kStateRender,
+    kPresent,
+    kRenderBackground,
+    kRenderBalls,
+    kRenderNumbers,
+    kRenderStickman,
+    kRenderParticles,
+    kRenderHud,
+    kCount
+};
+
+constexpr int kProfileZoneCount = static_cast<int>(ProfileZone::kCount);
+
+// Ticks spent per zone during one Game frame, plus the frame itself (input to
+// present, excluding the pacing wait).
+struct ProfileFrame {
+    Uint64 zone_ticks[kProfileZoneCount] = {};
+    Uint64 frame_ticks = 0;
+};
+
+// Accumulates performance-counter ticks per zone, both as running totals and
+// per frame. Only fed by the PROFILE_* macros, which compile to nothing unless
+// ENABLE_PROFILER is defined.
+class Profiler {
+public:
+    static Profiler& Get();
+    static const char* ZoneName(ProfileZone zone);
+
+    void Add(ProfileZone zone, Uint64 ticks) {
+        const int index = static_cast<int>(zone);
+        total_ticks_[index] += ticks;
+        calls_[index]++;
+        current_.zone_ticks[index] += ticks;
+    }
+    void Reset();
+
+    Uint64 TotalTicks(ProfileZone zone) const { return total_ticks_[static_cast<int>(zone)]; }
+    Uint64 Calls(ProfileZone zone) const { return calls_[static_cast<int>(zone)]; }
+
+    // Frame bracketing. EndFrame publishes the frame to LastFrame(), folds it
+    // into the smoothed averages and appends a row to the trace if one is open.
+    void BeginFrame();
+    void EndFrame();
+    const ProfileFrame& LastFrame() const { return last_; }
+    Uint64 FrameCount() const { return frame_count_; }
+
+    // Exponential moving averages in microseconds, steady enough to read on
+    // the overlay.
+    double SmoothedMicros(ProfileZone zone) const { return smoothed_us_[static_cast<int>(zone)]; }
+    double SmoothedFrameMicros() const { return smoothed_frame_us_; }
+
+    // CSV trace: one header line, then one row per frame with the frame time
+    // and every zone in microseconds.
+    bool OpenTrace(const std::string& path);
+    void CloseTrace();
+
+    ~Profiler();
+
+private:
+    Uint64 total_ticks_[kProfileZoneCount] = {};
+    Uint64 calls_[kProfileZoneCount] = {};
+
+    ProfileFrame current_{};
+    ProfileFrame last_{};
+    Uint64 frame_start_ = 0;
+    Uint64 frame_count_ = 0;
+    double smoothed_us_[kProfileZoneCount] = {};
+    double smoothed_frame_us_ = 0.0;
+    std::FILE* trace_ = nullptr;
+
+    void WriteTraceRow(double micros_per_tick);
+};
+
+class ProfileScope {
+public:
+    explicit ProfileScope(ProfileZone zone) : zone_(zone), start_(SDL_GetPerformanceCounter()) {}
+    ~ProfileScope() { Profiler::Get().Add(zone_, SDL_GetPerformanceCounter() - start_); }
+
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+    ProfileZone zone_;
+    Uint64 start_;
+};
+
+#if defined(ENABLE_PROFILER)
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+#define PROFILE_SCOPE(zone) ProfileScope PROFILE_CONCAT(profile_scope_, __LINE__)(zone)
+#define PROFILE_BEGIN_FRAME() Profiler::Get().BeginFrame()
+#define PROFILE_END_FRAME() Profiler::Get().EndFrame()
+#else
+#define PROFILE_SCOPE(zone) ((void)0)
+#define PROFILE_BEGIN_FRAME() ((void)0)
+#define PROFILE_END_FRAME() ((void)0)
+#endif
@@ -0,0 +1,91 @@
+#include "ProfilerOverlay.h"
+
+#include <cstdio>
+
+#include "Assets.h"
+#include "Profiler.h"
+
+namespace {
+constexpr float kFrameBudgetMicros = 1000000.0f / 60.0f;
+constexpr float kPanelX = 4.0f;
+constexpr float kPanelY = 4.0f;
+constexpr float kRowHeight = 12.0f;
+constexpr float kFontScale = 0.4f;
+constexpr float kSwatchSize = 8.0f;
+constexpr float kValueX = kPanelX + 14.0f;
+constexpr float kBarX = kPanelX + 64.0f;
+constexpr float kBarWidth = 150.0f;
+
+// Overlay rows, top to bottom, after the leading whole-frame row.
+const ProfileZone kRows[] = {
+    ProfileZone::kProcessEvents,
+    ProfileZone::kStateUpdate,
+    ProfileZone::kStateRender,
+    ProfileZone::kRenderBackground,
+    ProfileZone::kRenderBalls,
+    ProfileZone::kRenderNumbers,
+    ProfileZone::kRenderStickman,
+    ProfileZone::kRenderParticles,
+    ProfileZone::kRenderHud,
+    ProfileZone::kPresent,
+};
+constexpr int kRowCount = static_cast<int>(sizeof(kRows) / sizeof(kRows[0]));
+
+const SDL_Color kRowColors[kRowCount + 1] = {
+    {255, 255, 255, 255},
+    {255, 200, 0, 255},
+    {0, 200, 255, 255},
+    {80, 140, 255, 255},
+    {150, 150, 150, 255},
+    {255, 120, 120, 255},
+    {120, 255, 120, 255},
+    {255, 120, 255, 255},
+    {255, 60, 60, 255},
+    {255, 255, 120, 255},
+    {255, 140, 0, 255},
+};
+
+void DrawRow(RenderQueue& queue, TextBatch* text, const RenderContext& screen, int row, double micros) {
+    const SDL_Color color = kRowColors[row];
+    const float y = kPanelY + 2.0f + static_cast<float>(row) * kRowHeight;
+
+    const SDL_FRect swatch{kPanelX + 2.0f, y + 1.0f, kSwatchSize, kSwatchSize};
+    queue.AddFill(swatch, color);
+
+    float fraction = static_cast<float>(micros) / kFrameBudgetMicros;
+    if (fraction > 1.0f) {
+        fraction = 1.0f;
+    }
+    const SDL_FRect bar{kBarX, y + 1.0f, kBarWidth * fraction, kSwatchSize};
+    queue.AddFill(bar, color);
+
+    char value_text[12];
+    std::snprintf(value_text, sizeof(value_text), "%d", static_cast<int>(micros + 0.5));
+    text->Add(screen, value_text, kValueX, y, kFontScale, color);
+}
+}
+
+void DrawProfilerOverlay(RenderQueue& queue, const Assets& assets) {
+    const Profiler& profiler = Profiler::Get();
+    const BitmapFont* font = assets.GetFont(FontId::kNumberTime);
+    // Identity context: the overlay is laid out in screen pixels.
+    const RenderContext screen{};
+
+    const RenderLayer previous_layer = queue.Layer();
+    queue.SetLayer(RenderLayer::kDebug);
+
+    const SDL_FRect panel{kPanelX, kPanelY, kBarX - kPanelX + kBarWidth + 4.0f, 4.0f + (kRowCount + 1) * kRowHeight};
+    queue.AddFill(panel, SDL_Color{0, 0, 0, 170});
+
+    // Budget marker at the right edge of the bars.
+    const SDL_FRect budget{kBarX + kBarWidth, kPanelY, 1.0f, panel.h};
+    queue.AddFill(budget, SDL_Color{255, 255, 255, 90});
+
+    // Fills and text each end up as one batch: the bars, then all row values.
+    TextBatch text(queue, font);
+    DrawRow(queue, &text, screen, 0, profiler.SmoothedFrameMicros());
+    for (int i = 0; i < kRowCount; ++i) {
+        DrawRow(queue, &text, screen, i + 1, profiler.SmoothedMicros(kRows[i]));
+    }
+    queue.SetLayer(previous_layer);
+}
@@ -0,0 +1,14 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+
+#include "RenderQueue.h"
+
+class Assets;
+
+// Draws the profiler's smoothed per-zone timings in screen pixels at the top
+// left: one row per zone with a colour key, the time in microseconds and a bar
+// scaled to the 60 FPS frame budget. The digit-only NumberTime font is used,
+// so zones are identified by row order (see codex.md) and colour. Queued on
+// RenderLayer::kDebug, above everything the state drew.
+void DrawProfilerOverlay(RenderQueue& queue, const Assets& assets);
@@ -0,0 +1,31 @@
+#include "Random.h"
+
+#include <random>
+
+namespace {
+unsigned int g_seed = 5489u;
+
+std::mt19937& Engine() {
+    static std::mt19937 rng{g_seed};
+    return rng;
+}
+}
+
+void SeedRandom(unsigned int seed) {
+    g_seed = seed;
+    Engine().seed(seed);
+}
+
+unsigned int RandomSeed() {
+    return g_seed;
+}
+
+float RandomRange(float min_value, float max_value) {
+    std::uniform_real_distribution<float> dist(min_value, max_value);
+    return dist(Engine());
+}
+
+int RandomInt(int min_value, int max_value) {
+    std::uniform_int_distribution<int> dist(min_value, max_value);
+    return dist(Engine());
+}
@@ -0,0 +1,9 @@
+#pragma once
+
+// Gameplay RNG shared by all states. Seeding it makes a run reproducible
+// (headless benchmarks, replays); Game::Init seeds it once at startup.
+void SeedRandom(unsigned int seed);
+unsigned int RandomSeed();
+
+float RandomRange(float min_value, float max_value);
+int RandomInt(int min_value, int max_value);
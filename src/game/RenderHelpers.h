@@ -4,46 +4,46 @@
 
 #include "RenderContext.h"
 #include "Assets.h"
+#include "RenderQueue.h"
 
-inline void DrawTexture(SDL_Renderer* renderer, const RenderContext& ctx, const TextureAsset& asset,
+// Sprite helpers in design units. They queue into `queue` (see RenderQueue);
+// nothing reaches the renderer until the queue is flushed.
+
+inline SDL_Color TintWithAlpha(SDL_Color color, float alpha) {
+    return SDL_Color{color.r, color.g, color.b, static_cast<Uint8>(alpha * 255.0f)};
+}
+
+inline void DrawTexture(RenderQueue& queue, const RenderContext& ctx, const TextureAsset& asset,
                         float x, float y, float scale_x, float scale_y, SDL_Color color, float alpha = 1.0f) {
-    if (!asset.texture) {
-        return;
-    }
-    SDL_SetTextureColorMod(asset.texture, color.r, color.g, color.b);
-    SDL_SetTextureAlphaMod(asset.texture, static_cast<Uint8>(alpha * 255.0f));
-    SDL_FRect dst{ctx.offset_x + x * ctx.scale,
-                 ctx.offset_y + y * ctx.scale,
-                 static_cast<float>(asset.width) * scale_x * ctx.scale,
-                 static_cast<float>(asset.height) * scale_y * ctx.scale};
-    SDL_RenderCopyF(renderer, asset.texture, nullptr, &dst);
+    const SDL_FRect dst{ctx.offset_x + x * ctx.scale,
+                        ctx.offset_y + y * ctx.scale,
+                        static_cast<float>(asset.width) * scale_x * ctx.scale,
+                        static_cast<float>(asset.height) * scale_y * ctx.scale};
+    queue.AddSprite(asset.texture, asset.src, dst, TintWithAlpha(color, alpha));
 }
 
-inline void DrawTextureCentered(SDL_Renderer* renderer, const RenderContext& ctx, const TextureAsset& asset,
+inline void DrawTextureCentered(RenderQueue& queue, const RenderContext& ctx, const TextureAsset& asset,
                                 float x, float y, float scale_x, float scale_y, SDL_Color color, float alpha = 1.0f) {
-    if (!asset.texture) {
-        return;
-    }
-    SDL_SetTextureColorMod(asset.texture, color.r, color.g, color.b);
-    SDL_SetTextureAlphaMod(asset.texture, static_cast<Uint8>(alpha * 255.0f));
-    SDL_FRect dst{ctx.offset_x + (x - static_cast<float>(asset.width) * 0.5f * scale_x) * ctx.scale,
-                 ctx.offset_y + (y - static_cast<float>(asset.height) * 0.5f * scale_y) * ctx.scale,
-                 static_cast<float>(asset.width) * scale_x * ctx.scale,
-                 static_cast<float>(asset.height) * scale_y * ctx.scale};
-    SDL_RenderCopyF(renderer, asset.texture, nullptr, &dst);
+    const SDL_FRect dst{ctx.offset_x + (x - static_cast<float>(asset.width) * 0.5f * scale_x) * ctx.scale,
+                        ctx.offset_y + (y - static_cast<float>(asset.height) * 0.5f * scale_y) * ctx.scale,
+                        static_cast<float>(asset.width) * scale_x * ctx.scale,
+                        static_cast<float>(asset.height) * scale_y * ctx.scale};
+    queue.AddSprite(asset.texture, asset.src, dst, TintWithAlpha(color, alpha));
 }
 
-inline void DrawTextureSubrect(SDL_Renderer* renderer, const RenderContext& ctx, const TextureAsset& asset,
+inline void DrawTextureSubrect(RenderQueue& queue, const RenderContext& ctx, const TextureAsset& asset,
                                const SDL_Rect& src, float x, float y, float scale_x, float scale_y,
                                SDL_Color color, float alpha = 1.0f) {
-    if (!asset.texture) {
-        return;
-    }
-    SDL_SetTextureColorMod(asset.texture, color.r, color.g, color.b);
-    SDL_SetTextureAlphaMod(asset.texture, static_cast<Uint8>(alpha * 255.0f));
-    SDL_FRect dst{ctx.offset_x + x * ctx.scale,
-                 ctx.offset_y + y * ctx.scale,
-                 static_cast<float>(src.w) * scale_x * ctx.scale,
-                 static_cast<float>(src.h) * scale_y * ctx.scale};
-    SDL_RenderCopyF(renderer, asset.texture, &src, &dst);
+    const SDL_FRect dst{ctx.offset_x + x * ctx.scale,
+                        ctx.offset_y + y * ctx.scale,
+                        static_cast<float>(src.w) * scale_x * ctx.scale,
+                        static_cast<float>(src.h) * scale_y * ctx.scale};
+    // `src` is in design units; prescaled textures are smaller than that, so
+    // map its edges onto the texture before offsetting into asset.src.
+    const int left = asset.width > 0 ? src.x * asset.src.w / asset.width : src.x;
+    const int right = asset.width > 0 ? (src.x + src.w) * asset.src.w / asset.width : src.x + src.w;
+    const int top = asset.height > 0 ? src.y * asset.src.h / asset.height : src.y;
+    const int bottom = asset.height > 0 ? (src.y + src.h) * asset.src.h / asset.height : src.y + src.h;
+    const SDL_Rect atlas_src{asset.src.x + left, asset.src.y + top, right - left, bottom - top};
+    queue.AddSprite(asset.texture, atlas_src, dst, TintWithAlpha(color, alpha));
 }
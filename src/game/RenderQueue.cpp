@@ -0,0 +1,202 @@
+#include "RenderQueue.h"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+#include "RenderStats.h"
+
+namespace {
+// How many batches a command may jump back over to find its texture. Keeps
+// the overlap tests bounded on busy frames.
+constexpr int kMaxLookback = 8;
+
+bool Intersects(const SDL_FRect& a, const SDL_FRect& b) {
+    return a.x < b.x + b.w && b.x < a.x + a.w && a.y < b.y + b.h && b.y < a.y + a.h;
+}
+
+#if defined(RENDER_QUEUE_USE_GEOMETRY)
+constexpr float kDegToRad = 3.14159265358979323846f / 180.0f;
+#else
+bool SameColor(SDL_Color a, SDL_Color b) {
+    return a.r == b.r && a.g == b.g && a.b == b.b && a.a == b.a;
+}
+#endif
+}  // namespace
+
+void RenderQueue::AddSprite(SDL_Texture* texture, const SDL_Rect& src, const SDL_FRect& dst, SDL_Color color,
+                            float angle, bool flip_x) {
+    if (!texture) {
+        return;
+    }
+    SDL_FRect bounds = dst;
+    if (angle != 0.0f) {
+        // Any rotation stays inside the circle through the corners.
+        const float radius = 0.5f * std::sqrt(dst.w * dst.w + dst.h * dst.h);
+        bounds = SDL_FRect{dst.x + dst.w * 0.5f - radius, dst.y + dst.h * 0.5f - radius, radius * 2.0f, radius * 2.0f};
+    }
+    commands_.push_back(Command{texture, src, dst, bounds, color, angle, flip_x, layer_});
+}
+
+void RenderQueue::AddFill(const SDL_FRect& dst, SDL_Color color) {
+    commands_.push_back(Command{nullptr, SDL_Rect{0, 0, 0, 0}, dst, dst, color, 0.0f, false, layer_});
+}
+
+void RenderQueue::Flush(SDL_Renderer* renderer) {
+    layer_ = RenderLayer::kWorld;
+    if (commands_.empty()) {
+        return;
+    }
+    order_.resize(commands_.size());
+    for (size_t i = 0; i < order_.size(); ++i) {
+        order_[i] = static_cast<int>(i);
+    }
+    std::stable_sort(order_.begin(), order_.end(),
+                     [this](int a, int b) { return commands_[a].layer < commands_[b].layer; });
+
+    batch_count_ = 0;
+    size_t first = 0;
+    while (first < order_.size()) {
+        size_t last = first;
+        while (last < order_.size() && commands_[order_[last]].layer == commands_[order_[first]].layer) {
+            ++last;
+        }
+        BuildBatches(static_cast<int>(first), static_cast<int>(last));
+        first = last;
+    }
+    for (int i = 0; i < batch_count_; ++i) {
+        DrawBatch(renderer, batches_[i]);
+    }
+    commands_.clear();
+}
+
+void RenderQueue::BuildBatches(int first, int last) {
+    const int layer_first_batch = batch_count_;
+    for (int i = first; i < last; ++i) {
+        const int index = order_[i];
+        const Command& command = commands_[index];
+        int target = -1;
+        const int lookback_end = std::max(layer_first_batch, batch_count_ - kMaxLookback);
+        for (int b = batch_count_ - 1; b >= lookback_end; --b) {
+            if (batches_[b].texture == command.texture) {
+                target = b;
+                break;
+            }
+            if (Overlaps(command, batches_[b])) {
+                break;
+            }
+        }
+        if (target < 0) {
+            if (batch_count_ == static_cast<int>(batches_.size())) {
+                batches_.emplace_back();
+            }
+            target = batch_count_++;
+            batches_[target].texture = command.texture;
+            batches_[target].commands.clear();
+        }
+        batches_[target].commands.push_back(index);
+    }
+}
+
+bool RenderQueue::Overlaps(const Command& command, const Batch& batch) const {
+    for (int index : batch.commands) {
+        if (Intersects(command.bounds, commands_[index].bounds)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void RenderQueue::DrawBatch(SDL_Renderer* renderer, const Batch& batch) {
+    RenderStats& stats = FrameRenderStats();
+    if (!batch.texture) {
+        SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+        stats.RecordStateChange();
+        for (int index : batch.commands) {
+            const Command& command = commands_[index];
+            SDL_SetRenderDrawColor(renderer, command.color.r, command.color.g, command.color.b, command.color.a);
+            SDL_RenderFillRectF(renderer, &command.dst);
+            stats.RecordStateChange();
+            stats.RecordDraw(nullptr);
+        }
+        return;
+    }
+
+#if defined(RENDER_QUEUE_USE_GEOMETRY)
+    int page_w = 0;
+    int page_h = 0;
+    if (SDL_QueryTexture(batch.texture, nullptr, nullptr, &page_w, &page_h) != 0 || page_w <= 0 || page_h <= 0) {
+        return;
+    }
+    const float inv_page_w = 1.0f / static_cast<float>(page_w);
+    const float inv_page_h = 1.0f / static_cast<float>(page_h);
+
+    vertices_.clear();
+    indices_.clear();
+    for (int index : batch.commands) {
+        const Command& command = commands_[index];
+        const float radians = command.angle * kDegToRad;
+        const float cos_a = command.angle != 0.0f ? std::cos(radians) : 1.0f;
+        const float sin_a = command.angle != 0.0f ? std::sin(radians) : 0.0f;
+        const float half_w = command.dst.w * 0.5f;
+        const float half_h = command.dst.h * 0.5f;
+        const float center_x = command.dst.x + half_w;
+        const float center_y = command.dst.y + half_h;
+
+        float u0 = static_cast<float>(command.src.x) * inv_page_w;
+        float u1 = static_cast<float>(command.src.x + command.src.w) * inv_page_w;
+        const float v0 = static_cast<float>(command.src.y) * inv_page_h;
+        const float v1 = static_cast<float>(command.src.y + command.src.h) * inv_page_h;
+        if (command.flip_x) {
+            std::swap(u0, u1);
+        }
+
+        const float corner_x[4] = {-half_w, half_w, half_w, -half_w};
+        const float corner_y[4] = {-half_h, -half_h, half_h, half_h};
+        const float corner_u[4] = {u0, u1, u1, u0};
+        const float corner_v[4] = {v0, v0, v1, v1};
+        const int base = static_cast<int>(vertices_.size());
+        for (int i = 0; i < 4; ++i) {
+            SDL_Vertex vertex;
+            vertex.position.x = center_x + corner_x[i] * cos_a - corner_y[i] * sin_a;
+            vertex.position.y = center_y + corner_x[i] * sin_a + corner_y[i] * cos_a;
+            vertex.color = command.color;
+            vertex.tex_coord.x = corner_u[i];
+            vertex.tex_coord.y = corner_v[i];
+            vertices_.push_back(vertex);
+        }
+        const int quad_indices[6] = {0, 1, 2, 0, 2, 3};
+        for (int i = 0; i < 6; ++i) {
+            indices_.push_back(base + quad_indices[i]);
+        }
+    }
+    // Tint and alpha travel in the vertices; keep the shared page neutral.
+    SDL_SetTextureColorMod(batch.texture, 255, 255, 255);
+    SDL_SetTextureAlphaMod(batch.texture, 255);
+    stats.RecordStateChange();
+    SDL_RenderGeometry(renderer, batch.texture, vertices_.data(), static_cast<int>(vertices_.size()), indices_.data(),
+                       static_cast<int>(indices_.size()));
+    stats.RecordDraw(batch.texture);
+#else
+    bool mods_set = false;
+    SDL_Color mods{255, 255, 255, 255};
+    for (int index : batch.commands) {
+        const Command& command = commands_[index];
+        if (!mods_set || !SameColor(command.color, mods)) {
+            SDL_SetTextureColorMod(batch.texture, command.color.r, command.color.g, command.color.b);
+            SDL_SetTextureAlphaMod(batch.texture, command.color.a);
+            stats.RecordStateChange();
+            mods = command.color;
+            mods_set = true;
+        }
+        if (command.angle != 0.0f || command.flip_x) {
+            const SDL_FPoint center{command.dst.w * 0.5f, command.dst.h * 0.5f};
+            SDL_RenderCopyExF(renderer, batch.texture, &command.src, &command.dst, command.angle, &center,
+                              command.flip_x ? SDL_FLIP_HORIZONTAL : SDL_FLIP_NONE);
+        } else {
+            SDL_RenderCopyF(renderer, batch.texture, &command.src, &command.dst);
+        }
+        stats.RecordDraw(batch.texture);
+    }
+#endif
+}
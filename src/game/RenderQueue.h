@@ -0,0 +1,79 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+#include <cstdint>
+#include <vector>
+
+// SDL_RenderGeometry arrived in SDL 2.0.18; older SDL draws one
+// SDL_RenderCopyExF per command.
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+#define RENDER_QUEUE_USE_GEOMETRY 1
+#endif
+
+// Draw order between layers is fixed. Within a layer, commands keep their
+// submission order except that one may move back to join earlier commands
+// using the same texture, provided it overlaps nothing drawn in between.
+enum class RenderLayer : std::uint8_t {
+    kBackground,
+    kWorld,
+    kHud,
+    kOverlay,  // result panel veil and everything on it
+    kDebug,    // profiler overlay
+    kCount
+};
+
+// Deferred sprite submission. States (through the DrawTexture helpers,
+// BitmapFont and SkeletonInstance) add textured quads and filled rects during
+// Render; Flush groups them by layer and texture and submits each group as
+// one SDL_RenderGeometry call with tint and alpha carried in the vertex
+// colours, so texture colour/alpha mods are only reset once per group.
+// FrameRenderStats counts the resulting draw calls and state changes.
+class RenderQueue {
+public:
+    // Subsequent commands go to `layer`. Flush resets it to kWorld.
+    void SetLayer(RenderLayer layer) { layer_ = layer; }
+    RenderLayer Layer() const { return layer_; }
+
+    // `dst` is rotated `angle` degrees clockwise about its center; `flip_x`
+    // mirrors `src` horizontally. `color.a` is the alpha.
+    void AddSprite(SDL_Texture* texture, const SDL_Rect& src, const SDL_FRect& dst, SDL_Color color,
+                   float angle = 0.0f, bool flip_x = false);
+    // Alpha-blended solid rectangle.
+    void AddFill(const SDL_FRect& dst, SDL_Color color);
+
+    // Draws everything queued since the last Flush and empties the queue.
+    void Flush(SDL_Renderer* renderer);
+    int CommandCount() const { return static_cast<int>(commands_.size()); }
+
+private:
+    struct Command {
+        SDL_Texture* texture;  // null for fills
+        SDL_Rect src;
+        SDL_FRect dst;
+        SDL_FRect bounds;  // screen-space box around the rotated quad
+        SDL_Color color;
+        float angle;
+        bool flip_x;
+        RenderLayer layer;
+    };
+
+    struct Batch {
+        SDL_Texture* texture = nullptr;
+        std::vector<int> commands;
+    };
+
+    RenderLayer layer_ = RenderLayer::kWorld;
+    std::vector<Command> commands_;
+    std::vector<int> order_;
+    // Batches are reused across flushes so their command lists keep capacity.
+    std::vector<Batch> batches_;
+    int batch_count_ = 0;
+#if defined(RENDER_QUEUE_USE_GEOMETRY)
+    std::vector<SDL_Vertex> vertices_;
+    std::vector<int> indices_;
+#endif
+
+    void BuildBatches(int first, int last);
+    bool Overlaps(const Command& command, const Batch& batch) const;
+    void DrawBatch(SDL_Renderer* renderer, const Batch& batch);
+};
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+
+// Per-frame counters fed by RenderQueue::Flush (and the few direct draws) so
+// benchmarks can see how often the renderer has to switch textures (and
+// therefore break a batch) or change colour, alpha and blend state.
+struct RenderStats {
+    int draw_calls = 0;
+    int texture_switches = 0;
+    int state_changes = 0;
+    SDL_Texture* last_texture = nullptr;
+
+    void Reset() {
+        draw_calls = 0;
+        texture_switches = 0;
+        state_changes = 0;
+        last_texture = nullptr;
+    }
+
+    void RecordStateChange() { state_changes++; }
+
+    void RecordDraw(SDL_Texture* texture) {
+        draw_calls++;
+        if (texture != last_texture) {
+            texture_switches++;
+            last_texture = texture;
+        }
+    }
+};
+
+inline RenderStats& FrameRenderStats() {
+    static RenderStats stats;
+    return stats;
+}
@@ -0,0 +1,134 @@
+#include "SkeletonData.h"
+
+#include <SDL2/SDL.h>
+#include <algorithm>
+#include <cmath>
+
+#include "SkeletonInstance.h"
+
+namespace {
+constexpr float kDegToRad = 3.14159265358979323846f / 180.0f;
+// Hand-tuned nudges for the stickman's limbs, in bone space.
+constexpr float kLegSlotYOffset = 9.0f;
+constexpr float kHandSlotYOffset = 3.0f;
+}
+
+bool SkeletonData::Load(const std::string& compiled_path, const std::string& json_path, const std::string& atlas_path) {
+    Unload();
+    if (!file_.Open(compiled_path) || !BindSkeleton(file_.Data(), file_.Size(), &view_)) {
+        file_.Close();
+        std::string error;
+        if (!CompileSkeleton(json_path, atlas_path, &compiled_, &error) ||
+            !BindSkeleton(compiled_.data(), compiled_.size(), &view_)) {
+            SDL_Log("skeleton load failed: %s", error.c_str());
+            Unload();
+            return false;
+        }
+    }
+    bool fits = view_.BoneCount() <= kMaxSkeletonBones && view_.SlotCount() <= kMaxSkeletonSlots;
+    for (int i = 0; i < view_.AnimationCount(); ++i) {
+        fits &= view_.animations[i].timeline_count <= static_cast<std::uint32_t>(kMaxSkeletonTimelines);
+    }
+    if (!fits) {
+        SDL_Log("skeleton %s exceeds %d bones / %d slots / %d timelines", json_path.c_str(), kMaxSkeletonBones,
+                kMaxSkeletonSlots, kMaxSkeletonTimelines);
+        Unload();
+        return false;
+    }
+    BuildGeometry();
+    loaded_ = true;
+    return true;
+}
+
+void SkeletonData::Unload() {
+    loaded_ = false;
+    view_ = SkeletonView{};
+    file_.Close();
+    compiled_.clear();
+    compiled_.shrink_to_fit();
+    geometry_.clear();
+    bake_hz_ = 0.0f;
+    baked_animations_.clear();
+    baked_.clear();
+}
+
+bool SkeletonData::Bake(float hz, bool lerp) {
+    if (!loaded_ || hz <= 0.0f) {
+        return false;
+    }
+    // Sample through a live instance; bake_hz_ stays 0 until the table is
+    // complete so the instance poses normally.
+    bake_hz_ = 0.0f;
+    baked_animations_.assign(view_.AnimationCount(), BakedAnimation{});
+    baked_.clear();
+
+    SkeletonInstance sampler;
+    sampler.Bind(this);
+    const int slot_count = view_.SlotCount();
+    int total_frames = 0;
+    for (int a = 0; a < view_.AnimationCount(); ++a) {
+        const float duration = view_.animations[a].duration;
+        BakedAnimation& baked = baked_animations_[a];
+        baked.first_frame = total_frames;
+        baked.frame_count = static_cast<int>(std::ceil(duration * hz)) + 1;
+        total_frames += baked.frame_count;
+    }
+    baked_.resize(static_cast<size_t>(total_frames) * slot_count);
+
+    for (int a = 0; a < view_.AnimationCount(); ++a) {
+        sampler.SetAnimation(view_.Name(view_.animations[a].name), false, true);
+        const float duration = view_.animations[a].duration;
+        for (int frame = 0; frame < baked_animations_[a].frame_count; ++frame) {
+            sampler.Seek(std::min(static_cast<float>(frame) / hz, duration));
+            SkeletonSlotPlacement* out = &baked_[static_cast<size_t>(baked_animations_[a].first_frame + frame) * slot_count];
+            for (int slot = 0; slot < slot_count; ++slot) {
+                out[slot] = sampler.Place(slot, 0.0f, 0.0f);
+            }
+        }
+    }
+    bake_hz_ = hz;
+    bake_lerp_ = lerp;
+    return true;
+}
+
+void SkeletonData::BuildGeometry() {
+    geometry_.assign(view_.header->attachment_count, SkeletonAttachmentGeometry{});
+    for (size_t i = 0; i < geometry_.size(); ++i) {
+        const SkeletonAttachmentRecord& attachment = view_.attachments[i];
+        if (attachment.region < 0) {
+            continue;
+        }
+        const SkeletonRegionRecord& region = view_.regions[attachment.region];
+        const std::uint32_t slot_flags = view_.slots[attachment.slot].flags;
+
+        const float orig_w = (region.orig_w > 0) ? static_cast<float>(region.orig_w) : static_cast<float>(region.w);
+        const float orig_h = (region.orig_h > 0) ? static_cast<float>(region.orig_h) : static_cast<float>(region.h);
+        const float base_w = (attachment.width > 0.0f) ? attachment.width : orig_w;
+        const float base_h = (attachment.height > 0.0f) ? attachment.height : orig_h;
+        const float region_scale_x = (orig_w > 0.0f) ? (base_w / orig_w) : 1.0f;
+        const float region_scale_y = (orig_h > 0.0f) ? (base_h / orig_h) : 1.0f;
+
+        const float src_w = static_cast<float>(region.w);
+        const float src_h = static_cast<float>(region.h);
+        const float center_offset_x = (static_cast<float>(region.offset_x) + src_w * 0.5f - orig_w * 0.5f) * region_scale_x * attachment.scale_x;
+        const float center_offset_y = (orig_h * 0.5f - static_cast<float>(region.offset_y) - src_h * 0.5f) * region_scale_y * attachment.scale_y;
+
+        const float ar = attachment.rotation * kDegToRad;
+        const float ar_cos = std::cos(ar);
+        const float ar_sin = std::sin(ar);
+        const float leg_y_adjust = (slot_flags & kSlotLeg) ? kLegSlotYOffset : 0.0f;
+        const float hand_y_adjust = (slot_flags & kSlotHand) ? kHandSlotYOffset : 0.0f;
+
+        SkeletonAttachmentGeometry& geometry = geometry_[i];
+        geometry.drawable = true;
+        geometry.local_x = attachment.x + (center_offset_x * ar_cos - center_offset_y * ar_sin);
+        geometry.local_y = attachment.y + (center_offset_x * ar_sin + center_offset_y * ar_cos) + leg_y_adjust + hand_y_adjust;
+        geometry.width = src_w * region_scale_x * attachment.scale_x;
+        geometry.height = src_h * region_scale_y * attachment.scale_y;
+        geometry.rotation = attachment.rotation;
+        geometry.src_x = region.x;
+        geometry.src_y = region.y;
+        geometry.src_w = region.w;
+        geometry.src_h = region.h;
+    }
+}
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "AssetArchive.h"
+#include "SkeletonFormat.h"
+
+// Fixed pose buffer sizes for SkeletonInstance; Load rejects larger rigs.
+constexpr int kMaxSkeletonBones = 32;
+constexpr int kMaxSkeletonSlots = 32;
+constexpr int kMaxSkeletonTimelines = 64;
+
+// The pose-independent part of drawing an attachment, computed once at load:
+// the quad's center in bone space (region trim and rotation applied), its
+// unscaled size and the atlas sub-rect.
+struct SkeletonAttachmentGeometry {
+    bool drawable = false;
+    float local_x = 0.0f;
+    float local_y = 0.0f;
+    float width = 0.0f;
+    float height = 0.0f;
+    float rotation = 0.0f;
+    int src_x = 0;
+    int src_y = 0;
+    int src_w = 0;
+    int src_h = 0;
+};
+
+// Where one slot's attachment sits for a pose: quad center and angle in
+// degrees, before flipping. Baked per frame or computed live from bones.
+struct SkeletonSlotPlacement {
+    int attachment = -1;  // -1: the slot draws nothing
+    float x = 0.0f;
+    float y = 0.0f;
+    float angle = 0.0f;
+};
+
+// Immutable skeleton (bones, slots, attachments, regions, animations), loaded
+// once by Assets and shared by every SkeletonInstance that plays it.
+class SkeletonData {
+public:
+    SkeletonData() = default;
+    SkeletonData(const SkeletonData&) = delete;
+    SkeletonData& operator=(const SkeletonData&) = delete;
+
+    // Maps `compiled_path` (tools/SkeletonCompiler output) when it exists and
+    // validates; otherwise compiles the Spine JSON and atlas in memory.
+    bool Load(const std::string& compiled_path, const std::string& json_path, const std::string& atlas_path);
+    void Unload();
+
+    bool IsLoaded() const { return loaded_; }
+    const SkeletonView& View() const { return view_; }
+    int FindAnimation(const std::string& name) const { return view_.FindAnimation(name); }
+    const SkeletonAttachmentGeometry& Geometry(int attachment) const { return geometry_[attachment]; }
+
+    // Samples every animation at `hz` into a table of per-slot placements, so
+    // instances skip bone evaluation entirely. With `lerp` Draw blends the two
+    // nearest samples; otherwise it snaps to the nearest one.
+    bool Bake(float hz, bool lerp);
+    bool IsBaked() const { return bake_hz_ > 0.0f; }
+    float BakeHz() const { return bake_hz_; }
+    bool BakeLerp() const { return bake_lerp_; }
+    int BakedFrameCount(int animation) const { return baked_animations_[animation].frame_count; }
+    // Slot placements for one baked frame, SlotCount() entries.
+    const SkeletonSlotPlacement* BakedFrame(int animation, int frame) const {
+        const BakedAnimation& baked = baked_animations_[animation];
+        return &baked_[static_cast<size_t>(baked.first_frame + frame) * view_.SlotCount()];
+    }
+    size_t BakedBytes() const { return baked_.size() * sizeof(SkeletonSlotPlacement); }
+
+private:
+    bool loaded_ = false;
+    AssetFile file_;
+    std::vector<unsigned char> compiled_;
+    SkeletonView view_{};
+    std::vector<SkeletonAttachmentGeometry> geometry_;
+
+    struct BakedAnimation {
+        int first_frame = 0;
+        int frame_count = 0;
+    };
+    float bake_hz_ = 0.0f;
+    bool bake_lerp_ = true;
+    std::vector<BakedAnimation> baked_animations_;
+    std::vector<SkeletonSlotPlacement> baked_;
+
+    void BuildGeometry();
+};
@@ -0,0 +1,521 @@
+#include "SkeletonFormat.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <cstring>
+#include <map>
+#include <sstream>
+#include <unordered_map>
+
+#include "AssetArchive.h"
+#include "Json.h"
+
+namespace {
+constexpr float kYFlip = -1.0f;
+
+template <typename T>
+bool BindArray(const unsigned char* base, std::size_t size, std::uint32_t offset, std::uint32_t count, const T** out) {
+    if (offset % 4 != 0 || offset > size || (size - offset) / sizeof(T) < count) {
+        return false;
+    }
+    *out = reinterpret_cast<const T*>(base + offset);
+    return true;
+}
+
+bool InRange(std::int32_t index, std::uint32_t count, bool allow_none) {
+    if (index == -1) {
+        return allow_none;
+    }
+    return index >= 0 && static_cast<std::uint32_t>(index) < count;
+}
+
+float GetNumber(const JsonValue& obj, const std::string& key, float fallback) {
+    const JsonValue* value = obj.Get(key);
+    if (!value || !value->IsNumber()) {
+        return fallback;
+    }
+    return static_cast<float>(value->number_value);
+}
+
+std::string GetString(const JsonValue& obj, const std::string& key, const std::string& fallback) {
+    const JsonValue* value = obj.Get(key);
+    if (!value || !value->IsString()) {
+        return fallback;
+    }
+    return value->string_value;
+}
+
+bool IsSteppedFrame(const JsonValue& keyframe_obj) {
+    const JsonValue* curve = keyframe_obj.Get("curve");
+    return curve && curve->IsString() && curve->string_value == "stepped";
+}
+
+std::uint32_t SlotFlags(const std::string& slot_name) {
+    if (slot_name == "Lag" || slot_name == "Lag2") {
+        return kSlotLeg;
+    }
+    if (slot_name == "Hand" || slot_name == "Hand2") {
+        return kSlotHand;
+    }
+    return 0;
+}
+
+bool ReadFile(const std::string& path, std::string* out_contents) {
+    AssetFile file;
+    if (!file.Open(path)) {
+        return false;
+    }
+    out_contents->assign(reinterpret_cast<const char*>(file.Data()), file.Size());
+    return true;
+}
+
+std::string Trim(const std::string& value) {
+    size_t start = 0;
+    while (start < value.size() && std::isspace(static_cast<unsigned char>(value[start]))) {
+        start++;
+    }
+    size_t end = value.size();
+    while (end > start && std::isspace(static_cast<unsigned char>(value[end - 1]))) {
+        end--;
+    }
+    return value.substr(start, end - start);
+}
+
+// Named atlas region before it gets a string table offset.
+struct NamedRegion {
+    std::string name;
+    SkeletonRegionRecord record{};
+};
+
+bool ParseAtlas(const std::string& path, std::vector<NamedRegion>* regions) {
+    std::string contents;
+    if (!ReadFile(path, &contents)) {
+        return false;
+    }
+    std::istringstream file(contents);
+    std::string line;
+    bool in_regions = false;
+    NamedRegion current;
+
+    auto CommitRegion = [&]() {
+        if (!current.name.empty()) {
+            regions->push_back(current);
+        }
+    };
+
+    while (std::getline(file, line)) {
+        const std::string trimmed = Trim(line);
+        if (trimmed.empty()) {
+            continue;
+        }
+        if (trimmed.find(':') == std::string::npos && trimmed.find("Stickman.png") == std::string::npos) {
+            CommitRegion();
+            current = NamedRegion{};
+            current.name = trimmed;
+            in_regions = true;
+            continue;
+        }
+        if (!in_regions) {
+            continue;
+        }
+        const size_t colon = trimmed.find(':');
+        if (colon == std::string::npos) {
+            continue;
+        }
+        const std::string key = Trim(trimmed.substr(0, colon));
+        const std::string value = Trim(trimmed.substr(colon + 1));
+        SkeletonRegionRecord& region = current.record;
+        if (key == "rotate") {
+            region.rotated = (value == "true") ? 1 : 0;
+        } else if (key == "xy") {
+            std::sscanf(value.c_str(), "%d,%d", &region.x, &region.y);
+        } else if (key == "size") {
+            std::sscanf(value.c_str(), "%d,%d", &region.w, &region.h);
+        } else if (key == "orig") {
+            std::sscanf(value.c_str(), "%d,%d", &region.orig_w, &region.orig_h);
+        } else if (key == "offset") {
+            std::sscanf(value.c_str(), "%d,%d", &region.offset_x, &region.offset_y);
+        }
+    }
+    CommitRegion();
+    return true;
+}
+
+class StringTable {
+public:
+    std::uint32_t Add(const std::string& value) {
+        auto it = offsets_.find(value);
+        if (it != offsets_.end()) {
+            return it->second;
+        }
+        const std::uint32_t offset = static_cast<std::uint32_t>(bytes_.size());
+        bytes_.insert(bytes_.end(), value.begin(), value.end());
+        bytes_.push_back('\0');
+        offsets_[value] = offset;
+        return offset;
+    }
+    const std::vector<char>& Bytes() const { return bytes_; }
+
+private:
+    std::vector<char> bytes_;
+    std::unordered_map<std::string, std::uint32_t> offsets_;
+};
+
+// JSON objects iterate in hash order; sort entries so the compiled file is
+// reproducible.
+std::vector<std::pair<std::string, const JsonValue*>> SortedEntries(const JsonValue& object) {
+    std::vector<std::pair<std::string, const JsonValue*>> entries;
+    entries.reserve(object.object_value.size());
+    for (const auto& entry : object.object_value) {
+        entries.emplace_back(entry.first, &entry.second);
+    }
+    std::sort(entries.begin(), entries.end(),
+              [](const auto& a, const auto& b) { return a.first < b.first; });
+    return entries;
+}
+
+template <typename T>
+std::uint32_t AppendArray(std::vector<unsigned char>* blob, const std::vector<T>& values) {
+    while (blob->size() % 4 != 0) {
+        blob->push_back(0);
+    }
+    const std::uint32_t offset = static_cast<std::uint32_t>(blob->size());
+    if (!values.empty()) {
+        const unsigned char* bytes = reinterpret_cast<const unsigned char*>(values.data());
+        blob->insert(blob->end(), bytes, bytes + values.size() * sizeof(T));
+    }
+    return offset;
+}
+}  // namespace
+
+int SkeletonView::FindAnimation(const std::string& name) const {
+    for (int i = 0; i < AnimationCount(); ++i) {
+        if (name == Name(animations[i].name)) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+bool BindSkeleton(const void* data, std::size_t size, SkeletonView* out_view) {
+    const unsigned char* base = static_cast<const unsigned char*>(data);
+    if (!base || size < sizeof(SkeletonHeader) || reinterpret_cast<std::uintptr_t>(base) % 4 != 0) {
+        return false;
+    }
+    const SkeletonHeader* header = reinterpret_cast<const SkeletonHeader*>(base);
+    if (header->magic != kSkeletonMagic || header->version != kSkeletonVersion || header->size != size) {
+        return false;
+    }
+
+    SkeletonView view;
+    view.header = header;
+    if (!BindArray(base, size, header->bones_offset, header->bone_count, &view.bones) ||
+        !BindArray(base, size, header->slots_offset, header->slot_count, &view.slots) ||
+        !BindArray(base, size, header->attachments_offset, header->attachment_count, &view.attachments) ||
+        !BindArray(base, size, header->regions_offset, header->region_count, &view.regions) ||
+        !BindArray(base, size, header->animations_offset, header->animation_count, &view.animations) ||
+        !BindArray(base, size, header->timelines_offset, header->timeline_count, &view.timelines) ||
+        !BindArray(base, size, header->keys_offset, header->key_count, &view.keys) ||
+        !BindArray(base, size, header->strings_offset, header->string_bytes, &view.strings)) {
+        return false;
+    }
+    if (header->string_bytes == 0 || view.strings[header->string_bytes - 1] != '\0') {
+        return false;
+    }
+
+    // Validate every cross reference once so the renderer can index blindly.
+    for (std::uint32_t i = 0; i < header->bone_count; ++i) {
+        const std::int32_t parent = view.bones[i].parent;
+        if (parent >= static_cast<std::int32_t>(i) || parent < -1 || view.bones[i].name >= header->string_bytes) {
+            return false;
+        }
+    }
+    for (std::uint32_t i = 0; i < header->slot_count; ++i) {
+        const SkeletonSlotRecord& slot = view.slots[i];
+        if (!InRange(slot.bone, header->bone_count, true) || !InRange(slot.attachment, header->attachment_count, true) ||
+            slot.name >= header->string_bytes) {
+            return false;
+        }
+    }
+    for (std::uint32_t i = 0; i < header->attachment_count; ++i) {
+        const SkeletonAttachmentRecord& attachment = view.attachments[i];
+        if (!InRange(attachment.slot, header->slot_count, false) || !InRange(attachment.region, header->region_count, true)) {
+            return false;
+        }
+    }
+    for (std::uint32_t i = 0; i < header->animation_count; ++i) {
+        const SkeletonAnimationRecord& animation = view.animations[i];
+        if (animation.name >= header->string_bytes || animation.first_timeline > header->timeline_count ||
+            header->timeline_count - animation.first_timeline < animation.timeline_count) {
+            return false;
+        }
+    }
+    for (std::uint32_t i = 0; i < header->timeline_count; ++i) {
+        const SkeletonTimelineRecord& timeline = view.timelines[i];
+        const bool slot_timeline = timeline.type == SkeletonTimelineType::kAttachment;
+        if (timeline.target >= (slot_timeline ? header->slot_count : header->bone_count) || timeline.key_count == 0 ||
+            timeline.first_key > header->key_count || header->key_count - timeline.first_key < timeline.key_count) {
+            return false;
+        }
+        if (slot_timeline) {
+            for (std::uint32_t k = 0; k < timeline.key_count; ++k) {
+                if (!InRange(view.keys[timeline.first_key + k].value, header->attachment_count, true)) {
+                    return false;
+                }
+            }
+        }
+    }
+
+    *out_view = view;
+    return true;
+}
+
+bool CompileSkeleton(const std::string& json_path, const std::string& atlas_path, std::vector<unsigned char>* out_blob,
+                     std::string* out_error) {
+    std::string json_text;
+    if (!ReadFile(json_path, &json_text)) {
+        *out_error = "cannot read " + json_path;
+        return false;
+    }
+    JsonValue root;
+    if (!ParseJson(json_text, &root, out_error)) {
+        return false;
+    }
+    const JsonValue* bones = root.Get("bones");
+    const JsonValue* slots = root.Get("slots");
+    const JsonValue* skins = root.Get("skins");
+    if (!bones || !bones->IsArray() || !slots || !slots->IsArray() || !skins || !skins->IsObject()) {
+        *out_error = "missing bones/slots/skins";
+        return false;
+    }
+
+    std::vector<NamedRegion> named_regions;
+    if (!ParseAtlas(atlas_path, &named_regions)) {
+        *out_error = "cannot read " + atlas_path;
+        return false;
+    }
+
+    StringTable strings;
+    std::vector<SkeletonBoneRecord> bone_records;
+    std::vector<SkeletonSlotRecord> slot_records;
+    std::vector<SkeletonAttachmentRecord> attachment_records;
+    std::vector<SkeletonRegionRecord> region_records;
+    std::vector<SkeletonAnimationRecord> animation_records;
+    std::vector<SkeletonTimelineRecord> timeline_records;
+    std::vector<SkeletonKeyRecord> key_records;
+
+    std::unordered_map<std::string, int> region_indices;
+    for (const NamedRegion& region : named_regions) {
+        SkeletonRegionRecord record = region.record;
+        record.name = strings.Add(region.name);
+        region_indices[region.name] = static_cast<int>(region_records.size());
+        region_records.push_back(record);
+    }
+
+    // Spine lists parents before children, which the pose pass relies on.
+    std::unordered_map<std::string, int> bone_indices;
+    for (const auto& bone_value : bones->array_value) {
+        if (!bone_value.IsObject()) {
+            continue;
+        }
+        const std::string name = GetString(bone_value, "name", "");
+        const std::string parent_name = GetString(bone_value, "parent", "");
+        SkeletonBoneRecord record{};
+        record.name = strings.Add(name);
+        record.parent = -1;
+        if (!parent_name.empty()) {
+            auto it = bone_indices.find(parent_name);
+            if (it == bone_indices.end()) {
+                *out_error = "bone " + name + " listed before its parent";
+                return false;
+            }
+            record.parent = it->second;
+        }
+        record.x = GetNumber(bone_value, "x", 0.0f);
+        record.y = GetNumber(bone_value, "y", 0.0f) * kYFlip;
+        record.rotation = GetNumber(bone_value, "rotation", 0.0f) * kYFlip;
+        record.scale_x = GetNumber(bone_value, "scaleX", 1.0f);
+        record.scale_y = GetNumber(bone_value, "scaleY", 1.0f);
+        bone_indices[name] = static_cast<int>(bone_records.size());
+        bone_records.push_back(record);
+    }
+
+    std::unordered_map<std::string, int> slot_indices;
+    std::vector<std::string> slot_default_attachments;
+    for (const auto& slot_value : slots->array_value) {
+        if (!slot_value.IsObject()) {
+            continue;
+        }
+        const std::string name = GetString(slot_value, "name", "");
+        auto bone_it = bone_indices.find(GetString(slot_value, "bone", ""));
+        SkeletonSlotRecord record{};
+        record.name = strings.Add(name);
+        record.bone = (bone_it != bone_indices.end()) ? bone_it->second : -1;
+        record.attachment = -1;
+        record.flags = SlotFlags(name);
+        slot_indices[name] = static_cast<int>(slot_records.size());
+        slot_records.push_back(record);
+        slot_default_attachments.push_back(GetString(slot_value, "attachment", ""));
+    }
+
+    // Attachments are keyed by (slot, name); resolve them to indices here so
+    // the runtime never builds lookup strings.
+    std::map<std::pair<int, std::string>, int> attachment_indices;
+    const JsonValue* default_skin = skins->Get("default");
+    if (default_skin && default_skin->IsObject()) {
+        for (const auto& slot_entry : SortedEntries(*default_skin)) {
+            auto slot_it = slot_indices.find(slot_entry.first);
+            if (slot_it == slot_indices.end() || !slot_entry.second->IsObject()) {
+                continue;
+            }
+            for (const auto& attachment_entry : SortedEntries(*slot_entry.second)) {
+                const JsonValue& attachment_value = *attachment_entry.second;
+                if (!attachment_value.IsObject()) {
+                    continue;
+                }
+                auto region_it = region_indices.find(attachment_entry.first);
+                SkeletonAttachmentRecord record{};
+                record.name = strings.Add(attachment_entry.first);
+                record.slot = slot_it->second;
+                record.region = (region_it != region_indices.end()) ? region_it->second : -1;
+                record.x = GetNumber(attachment_value, "x", 0.0f);
+                record.y = GetNumber(attachment_value, "y", 0.0f) * kYFlip;
+                record.rotation = GetNumber(attachment_value, "rotation", 0.0f) * kYFlip;
+                record.scale_x = GetNumber(attachment_value, "scaleX", 1.0f);
+                record.scale_y = GetNumber(attachment_value, "scaleY", 1.0f);
+                record.width = GetNumber(attachment_value, "width", 0.0f);
+                record.height = GetNumber(attachment_value, "height", 0.0f);
+                attachment_indices[{slot_it->second, attachment_entry.first}] = static_cast<int>(attachment_records.size());
+                attachment_records.push_back(record);
+            }
+        }
+    }
+    auto FindAttachment = [&](int slot_index, const std::string& name) {
+        auto it = attachment_indices.find({slot_index, name});
+        return (it != attachment_indices.end()) ? it->second : -1;
+    };
+    for (size_t i = 0; i < slot_records.size(); ++i) {
+        slot_records[i].attachment = FindAttachment(static_cast<int>(i), slot_default_attachments[i]);
+    }
+
+    auto AppendTimeline = [&](SkeletonTimelineType type, int target, const JsonValue& frames, float* duration) {
+        SkeletonTimelineRecord timeline{};
+        timeline.type = type;
+        timeline.target = static_cast<std::uint16_t>(target);
+        timeline.first_key = static_cast<std::uint32_t>(key_records.size());
+        const float default_value = (type == SkeletonTimelineType::kScale) ? 1.0f : 0.0f;
+        for (const auto& frame_value : frames.array_value) {
+            if (!frame_value.IsObject()) {
+                continue;
+            }
+            SkeletonKeyRecord key{};
+            key.time = GetNumber(frame_value, "time", 0.0f);
+            switch (type) {
+            case SkeletonTimelineType::kRotate:
+                key.x = GetNumber(frame_value, "angle", 0.0f) * kYFlip;
+                key.value = IsSteppedFrame(frame_value) ? 1 : 0;
+                break;
+            case SkeletonTimelineType::kTranslate:
+            case SkeletonTimelineType::kScale: {
+                const float y_sign = (type == SkeletonTimelineType::kTranslate) ? kYFlip : 1.0f;
+                key.x = GetNumber(frame_value, "x", default_value);
+                key.y = GetNumber(frame_value, "y", default_value) * y_sign;
+                key.value = IsSteppedFrame(frame_value) ? 1 : 0;
+                break;
+            }
+            case SkeletonTimelineType::kAttachment:
+                key.value = FindAttachment(target, GetString(frame_value, "name", ""));
+                break;
+            }
+            key_records.push_back(key);
+            *duration = std::max(*duration, key.time);
+        }
+        timeline.key_count = static_cast<std::uint32_t>(key_records.size()) - timeline.first_key;
+        if (timeline.key_count > 0) {
+            timeline_records.push_back(timeline);
+        }
+    };
+
+    const JsonValue* animations = root.Get("animations");
+    if (animations && animations->IsObject()) {
+        for (const auto& animation_entry : SortedEntries(*animations)) {
+            const JsonValue& animation_value = *animation_entry.second;
+            if (!animation_value.IsObject()) {
+                continue;
+            }
+            SkeletonAnimationRecord record{};
+            record.name = strings.Add(animation_entry.first);
+            record.first_timeline = static_cast<std::uint32_t>(timeline_records.size());
+            float duration = 0.0f;
+
+            const JsonValue* slot_animations = animation_value.Get("slots");
+            if (slot_animations && slot_animations->IsObject()) {
+                for (const auto& slot_entry : SortedEntries(*slot_animations)) {
+                    auto slot_it = slot_indices.find(slot_entry.first);
+                    if (slot_it == slot_indices.end() || !slot_entry.second->IsObject()) {
+                        continue;
+                    }
+                    const JsonValue* frames = slot_entry.second->Get("attachment");
+                    if (frames && frames->IsArray()) {
+                        AppendTimeline(SkeletonTimelineType::kAttachment, slot_it->second, *frames, &duration);
+                    }
+                }
+            }
+
+            const JsonValue* bone_animations = animation_value.Get("bones");
+            if (bone_animations && bone_animations->IsObject()) {
+                for (const auto& bone_entry : SortedEntries(*bone_animations)) {
+                    auto bone_it = bone_indices.find(bone_entry.first);
+                    if (bone_it == bone_indices.end() || !bone_entry.second->IsObject()) {
+                        continue;
+                    }
+                    const JsonValue* rotate = bone_entry.second->Get("rotate");
+                    if (rotate && rotate->IsArray()) {
+                        AppendTimeline(SkeletonTimelineType::kRotate, bone_it->second, *rotate, &duration);
+                    }
+                    const JsonValue* translate = bone_entry.second->Get("translate");
+                    if (translate && translate->IsArray()) {
+                        AppendTimeline(SkeletonTimelineType::kTranslate, bone_it->second, *translate, &duration);
+                    }
+                    const JsonValue* scale = bone_entry.second->Get("scale");
+                    if (scale && scale->IsArray()) {
+                        AppendTimeline(SkeletonTimelineType::kScale, bone_it->second, *scale, &duration);
+                    }
+                }
+            }
+
+            record.duration = duration;
+            record.timeline_count = static_cast<std::uint32_t>(timeline_records.size()) - record.first_timeline;
+            animation_records.push_back(record);
+        }
+    }
+
+    std::vector<unsigned char>& blob = *out_blob;
+    blob.assign(sizeof(SkeletonHeader), 0);
+    SkeletonHeader header{};
+    header.magic = kSkeletonMagic;
+    header.version = kSkeletonVersion;
+    header.bone_count = static_cast<std::uint32_t>(bone_records.size());
+    header.slot_count = static_cast<std::uint32_t>(slot_records.size());
+    header.attachment_count = static_cast<std::uint32_t>(attachment_records.size());
+    header.region_count = static_cast<std::uint32_t>(region_records.size());
+    header.animation_count = static_cast<std::uint32_t>(animation_records.size());
+    header.timeline_count = static_cast<std::uint32_t>(timeline_records.size());
+    header.key_count = static_cast<std::uint32_t>(key_records.size());
+    header.string_bytes = static_cast<std::uint32_t>(strings.Bytes().size());
+    header.bones_offset = AppendArray(&blob, bone_records);
+    header.slots_offset = AppendArray(&blob, slot_records);
+    header.attachments_offset = AppendArray(&blob, attachment_records);
+    header.regions_offset = AppendArray(&blob, region_records);
+    header.animations_offset = AppendArray(&blob, animation_records);
+    header.timelines_offset = AppendArray(&blob, timeline_records);
+    header.keys_offset = AppendArray(&blob, key_records);
+    header.strings_offset = AppendArray(&blob, strings.Bytes());
+    while (blob.size() % 4 != 0) {
+        blob.push_back(0);
+    }
+    header.size = static_cast<std::uint32_t>(blob.size());
+    std::memcpy(blob.data(), &header, sizeof(header));
+    return true;
+}
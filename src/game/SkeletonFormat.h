@@ -0,0 +1,143 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Compiled skeleton layout, written by tools/SkeletonCompiler and bound in
+// place at runtime: a header followed by flat, 4-byte aligned record arrays
+// and one string table. Every cross reference is an array index, every name an
+// offset into the string table. Values are stored little-endian, already
+// converted to the game's y-down space.
+
+constexpr std::uint32_t kSkeletonMagic = 0x4c454b53;  // "SKEL"
+constexpr std::uint32_t kSkeletonVersion = 1;
+
+enum class SkeletonTimelineType : std::uint16_t {
+    kRotate,
+    kTranslate,
+    kScale,
+    kAttachment
+};
+
+// Slot flags for the per-limb offsets the hand-tuned renderer applies.
+constexpr std::uint32_t kSlotLeg = 1u << 0;
+constexpr std::uint32_t kSlotHand = 1u << 1;
+
+struct SkeletonBoneRecord {
+    std::uint32_t name;
+    std::int32_t parent;
+    float x;
+    float y;
+    float rotation;
+    float scale_x;
+    float scale_y;
+};
+
+struct SkeletonSlotRecord {
+    std::uint32_t name;
+    std::int32_t bone;
+    std::int32_t attachment;  // setup pose attachment, -1 for none
+    std::uint32_t flags;
+};
+
+struct SkeletonAttachmentRecord {
+    std::uint32_t name;
+    std::int32_t slot;
+    std::int32_t region;  // -1 when the atlas has no matching region
+    float x;
+    float y;
+    float rotation;
+    float scale_x;
+    float scale_y;
+    float width;
+    float height;
+};
+
+struct SkeletonRegionRecord {
+    std::uint32_t name;
+    std::int32_t x;
+    std::int32_t y;
+    std::int32_t w;
+    std::int32_t h;
+    std::int32_t orig_w;
+    std::int32_t orig_h;
+    std::int32_t offset_x;
+    std::int32_t offset_y;
+    std::int32_t rotated;
+};
+
+struct SkeletonAnimationRecord {
+    std::uint32_t name;
+    float duration;
+    std::uint32_t first_timeline;
+    std::uint32_t timeline_count;
+};
+
+struct SkeletonTimelineRecord {
+    SkeletonTimelineType type;
+    std::uint16_t target;  // bone index, or slot index for kAttachment
+    std::uint32_t first_key;
+    std::uint32_t key_count;
+};
+
+// Rotate keys use `x`; translate/scale use `x`/`y`. `value` is the stepped
+// flag for those, and the attachment index (-1 for none) for kAttachment.
+struct SkeletonKeyRecord {
+    float time;
+    float x;
+    float y;
+    std::int32_t value;
+};
+
+struct SkeletonHeader {
+    std::uint32_t magic;
+    std::uint32_t version;
+    std::uint32_t size;
+    std::uint32_t bone_count;
+    std::uint32_t slot_count;
+    std::uint32_t attachment_count;
+    std::uint32_t region_count;
+    std::uint32_t animation_count;
+    std::uint32_t timeline_count;
+    std::uint32_t key_count;
+    std::uint32_t string_bytes;
+    std::uint32_t bones_offset;
+    std::uint32_t slots_offset;
+    std::uint32_t attachments_offset;
+    std::uint32_t regions_offset;
+    std::uint32_t animations_offset;
+    std::uint32_t timelines_offset;
+    std::uint32_t keys_offset;
+    std::uint32_t strings_offset;
+};
+
+// Typed pointers into a compiled blob. Does not own the memory.
+struct SkeletonView {
+    const SkeletonHeader* header = nullptr;
+    const SkeletonBoneRecord* bones = nullptr;
+    const SkeletonSlotRecord* slots = nullptr;
+    const SkeletonAttachmentRecord* attachments = nullptr;
+    const SkeletonRegionRecord* regions = nullptr;
+    const SkeletonAnimationRecord* animations = nullptr;
+    const SkeletonTimelineRecord* timelines = nullptr;
+    const SkeletonKeyRecord* keys = nullptr;
+    const char* strings = nullptr;
+
+    int BoneCount() const { return static_cast<int>(header->bone_count); }
+    int SlotCount() const { return static_cast<int>(header->slot_count); }
+    int AnimationCount() const { return static_cast<int>(header->animation_count); }
+    const char* Name(std::uint32_t offset) const { return strings + offset; }
+    int FindAnimation(const std::string& name) const;
+};
+
+// Checks the header, bounds and every index once, then points `out_view` into
+// `data`. No allocation or copying; `data` must outlive the view and be 4-byte
+// aligned.
+bool BindSkeleton(const void* data, std::size_t size, SkeletonView* out_view);
+
+// Builds a compiled blob from Spine 2.1 JSON and its libGDX atlas. Used by the
+// offline compiler and as the runtime fallback when no compiled file exists.
+bool CompileSkeleton(const std::string& json_path, const std::string& atlas_path, std::vector<unsigned char>* out_blob,
+                     std::string* out_error);
@@ -0,0 +1,292 @@
+#include "SkeletonInstance.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+constexpr float kDegToRad = 3.14159265358979323846f / 180.0f;
+constexpr float kHandBackXOffset = 3.0f;
+
+// Moves `cursor` forward to the last key at or before `time` (it stays at 0
+// when `time` is before the first key). Playback only moves forward between
+// rewinds, so this is amortised O(1) instead of a scan from the first key.
+int AdvanceCursor(const SkeletonKeyRecord* keys, int count, float time, int cursor) {
+    while (cursor + 1 < count && time >= keys[cursor + 1].time) {
+        cursor++;
+    }
+    return cursor;
+}
+
+SDL_FPoint EvaluateKeys(const SkeletonKeyRecord* keys, int count, float time, int index) {
+    if (time <= keys[0].time) {
+        return SDL_FPoint{keys[0].x, keys[0].y};
+    }
+    const SkeletonKeyRecord& a = keys[index];
+    if (index + 1 >= count) {
+        return SDL_FPoint{a.x, a.y};
+    }
+    const SkeletonKeyRecord& b = keys[index + 1];
+    if (a.value != 0 || b.time <= a.time) {
+        return SDL_FPoint{a.x, a.y};
+    }
+    const float t = (time - a.time) / (b.time - a.time);
+    return SDL_FPoint{a.x + (b.x - a.x) * t, a.y + (b.y - a.y) * t};
+}
+
+// Blends two baked samples. Angles take the short way round; the attachment
+// switches at the first sample like a stepped key.
+SkeletonSlotPlacement LerpPlacement(const SkeletonSlotPlacement& a, const SkeletonSlotPlacement& b, float t) {
+    if (t <= 0.0f || a.attachment != b.attachment) {
+        return a;
+    }
+    float angle_delta = b.angle - a.angle;
+    if (angle_delta > 180.0f) {
+        angle_delta -= 360.0f;
+    } else if (angle_delta < -180.0f) {
+        angle_delta += 360.0f;
+    }
+    SkeletonSlotPlacement placement = a;
+    placement.x = a.x + (b.x - a.x) * t;
+    placement.y = a.y + (b.y - a.y) * t;
+    placement.angle = a.angle + angle_delta * t;
+    return placement;
+}
+
+}  // namespace
+
+bool SkeletonInstance::Bind(const SkeletonData* data) {
+    data_ = (data && data->IsLoaded()) ? data : nullptr;
+    current_animation_ = -1;
+    if (!data_) {
+        return false;
+    }
+    SetAnimation("Idle", true, true);
+    Pose();
+    return true;
+}
+
+bool SkeletonInstance::HasAnimation(const std::string& name) const {
+    return data_ && data_->FindAnimation(name) >= 0;
+}
+
+const char* SkeletonInstance::CurrentAnimation() const {
+    if (!data_ || current_animation_ < 0) {
+        return "";
+    }
+    const SkeletonView& view = data_->View();
+    return view.Name(view.animations[current_animation_].name);
+}
+
+bool SkeletonInstance::SetAnimation(const std::string& name, bool loop, bool restart) {
+    if (!data_) {
+        return false;
+    }
+    const int index = data_->FindAnimation(name);
+    if (index < 0) {
+        return false;
+    }
+    if (restart || current_animation_ != index) {
+        animation_time_ = 0.0f;
+    }
+    if (current_animation_ != index) {
+        cursors_.fill(0);
+    }
+    current_animation_ = index;
+    animation_loop_ = loop;
+    Pose();
+    return true;
+}
+
+void SkeletonInstance::Update(float delta_seconds) {
+    if (!data_ || current_animation_ < 0) {
+        return;
+    }
+    const float duration = data_->View().animations[current_animation_].duration;
+    if (duration <= 0.0f) {
+        animation_time_ = 0.0f;
+    } else {
+        animation_time_ += delta_seconds;
+        if (animation_loop_) {
+            animation_time_ = std::fmod(animation_time_, duration);
+            if (animation_time_ < 0.0f) {
+                animation_time_ += duration;
+            }
+        } else if (animation_time_ > duration) {
+            animation_time_ = duration;
+        }
+    }
+    Pose();
+}
+
+void SkeletonInstance::Seek(float time) {
+    if (!data_ || current_animation_ < 0) {
+        return;
+    }
+    const float duration = data_->View().animations[current_animation_].duration;
+    animation_time_ = std::max(0.0f, std::min(time, duration));
+    Pose();
+}
+
+void SkeletonInstance::Pose() {
+    if (data_->IsBaked()) {
+        return;
+    }
+    const SkeletonView& view = data_->View();
+    const int bone_count = view.BoneCount();
+    const int slot_count = view.SlotCount();
+    for (int i = 0; i < bone_count; ++i) {
+        const SkeletonBoneRecord& bone = view.bones[i];
+        bones_[i] = BoneLocal{bone.x, bone.y, bone.rotation, bone.scale_x, bone.scale_y};
+    }
+    for (int i = 0; i < slot_count; ++i) {
+        slot_attachments_[i] = view.slots[i].attachment;
+    }
+
+    if (current_animation_ >= 0) {
+        // Looping or restarting moves time backwards; cursors start over.
+        if (animation_time_ < cursor_time_) {
+            cursors_.fill(0);
+        }
+        cursor_time_ = animation_time_;
+
+        const SkeletonAnimationRecord& animation = view.animations[current_animation_];
+        for (std::uint32_t t = 0; t < animation.timeline_count; ++t) {
+            const SkeletonTimelineRecord& timeline = view.timelines[animation.first_timeline + t];
+            const SkeletonKeyRecord* keys = view.keys + timeline.first_key;
+            const int key_count = static_cast<int>(timeline.key_count);
+            const int key = AdvanceCursor(keys, key_count, animation_time_, cursors_[t]);
+            cursors_[t] = key;
+            switch (timeline.type) {
+            case SkeletonTimelineType::kRotate:
+                bones_[timeline.target].rotation += EvaluateKeys(keys, key_count, animation_time_, key).x;
+                break;
+            case SkeletonTimelineType::kTranslate: {
+                const SDL_FPoint offset = EvaluateKeys(keys, key_count, animation_time_, key);
+                bones_[timeline.target].x += offset.x;
+                bones_[timeline.target].y += offset.y;
+                break;
+            }
+            case SkeletonTimelineType::kScale: {
+                const SDL_FPoint scale_value = EvaluateKeys(keys, key_count, animation_time_, key);
+                bones_[timeline.target].scale_x *= scale_value.x;
+                bones_[timeline.target].scale_y *= scale_value.y;
+                break;
+            }
+            case SkeletonTimelineType::kAttachment:
+                slot_attachments_[timeline.target] = keys[key].value;
+                break;
+            }
+        }
+    }
+
+    for (int i = 0; i < bone_count; ++i) {
+        const BoneLocal& bone = bones_[i];
+        const int parent_index = view.bones[i].parent;
+        BonePose pose;
+        const float lr = bone.rotation * kDegToRad;
+        const float cos_r = std::cos(lr);
+        const float sin_r = std::sin(lr);
+        const float la = cos_r * bone.scale_x;
+        const float lb = -sin_r * bone.scale_y;
+        const float lc = sin_r * bone.scale_x;
+        const float ld = cos_r * bone.scale_y;
+        if (parent_index < 0) {
+            pose.world_x = bone.x;
+            pose.world_y = bone.y;
+            pose.a = la;
+            pose.b = lb;
+            pose.c = lc;
+            pose.d = ld;
+        } else {
+            const BonePose& parent = poses_[parent_index];
+            pose.world_x = parent.world_x + bone.x * parent.a + bone.y * parent.b;
+            pose.world_y = parent.world_y + bone.x * parent.c + bone.y * parent.d;
+            pose.a = parent.a * la + parent.b * lc;
+            pose.b = parent.a * lb + parent.b * ld;
+            pose.c = parent.c * la + parent.d * lc;
+            pose.d = parent.c * lb + parent.d * ld;
+        }
+        poses_[i] = pose;
+    }
+}
+
+SkeletonSlotPlacement SkeletonInstance::Place(int slot_index, float x, float y) const {
+    SkeletonSlotPlacement placement;
+    const SkeletonSlotRecord& slot = data_->View().slots[slot_index];
+    const int attachment = slot_attachments_[slot_index];
+    if (slot.bone < 0 || attachment < 0 || !data_->Geometry(attachment).drawable) {
+        return placement;
+    }
+    const SkeletonAttachmentGeometry& geometry = data_->Geometry(attachment);
+    const BonePose& bone = poses_[slot.bone];
+    placement.attachment = attachment;
+    placement.x = x + bone.world_x + geometry.local_x * bone.a + geometry.local_y * bone.b;
+    placement.y = y + bone.world_y + geometry.local_x * bone.c + geometry.local_y * bone.d;
+    placement.angle = std::atan2(bone.c, bone.a) / kDegToRad + geometry.rotation;
+    return placement;
+}
+
+void SkeletonInstance::Draw(RenderQueue& queue, const RenderContext& ctx, const TextureAsset& texture,
+                            float x, float y, float scale, SDL_Color color, bool flip_x) const {
+    if (!data_ || !texture.texture) {
+        return;
+    }
+
+    const SkeletonView& view = data_->View();
+    const int slot_count = view.SlotCount();
+
+    // Baked: the two samples around animation_time_ and the blend between them.
+    const SkeletonSlotPlacement* baked_a = nullptr;
+    const SkeletonSlotPlacement* baked_b = nullptr;
+    float baked_t = 0.0f;
+    if (data_->IsBaked()) {
+        if (current_animation_ < 0) {
+            return;
+        }
+        const int frame_count = data_->BakedFrameCount(current_animation_);
+        const float position = animation_time_ * data_->BakeHz();
+        int frame = static_cast<int>(data_->BakeLerp() ? position : position + 0.5f);
+        frame = std::min(frame, frame_count - 1);
+        baked_a = data_->BakedFrame(current_animation_, frame);
+        baked_b = data_->BakedFrame(current_animation_, std::min(frame + 1, frame_count - 1));
+        baked_t = data_->BakeLerp() ? std::min(1.0f, position - static_cast<float>(frame)) : 0.0f;
+    }
+
+    for (int slot_index = 0; slot_index < slot_count; ++slot_index) {
+        SkeletonSlotPlacement placement;
+        if (baked_a) {
+            placement = LerpPlacement(baked_a[slot_index], baked_b[slot_index], baked_t);
+            placement.x += x;
+            placement.y += y;
+        } else {
+            placement = Place(slot_index, x, y);
+        }
+        if (placement.attachment < 0) {
+            continue;
+        }
+        const SkeletonAttachmentGeometry& geometry = data_->Geometry(placement.attachment);
+        const bool hand_slot = (view.slots[slot_index].flags & kSlotHand) != 0;
+        const float draw_w = geometry.width * scale;
+        const float draw_h = geometry.height * scale;
+
+        float center_x = placement.x;
+        const float center_y = placement.y;
+        float angle = placement.angle;
+        if (flip_x) {
+            center_x = x - (center_x - x);
+            angle = -angle;
+        }
+        if (hand_slot) {
+            center_x += flip_x ? kHandBackXOffset : -kHandBackXOffset;
+        }
+
+        SDL_FRect dst{
+            ctx.offset_x + (center_x - draw_w * 0.5f) * ctx.scale,
+            ctx.offset_y + (center_y - draw_h * 0.5f) * ctx.scale,
+            draw_w * ctx.scale,
+            draw_h * ctx.scale
+        };
+        const SDL_Rect src{texture.src.x + geometry.src_x, texture.src.y + geometry.src_y, geometry.src_w, geometry.src_h};
+        queue.AddSprite(texture.texture, src, dst, color, angle, flip_x);
+    }
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+#include <array>
+#include <string>
+
+#include "Assets.h"
+#include "RenderContext.h"
+#include "RenderQueue.h"
+#include "SkeletonData.h"
+
+// Playback state for one character: the current animation, its time and the
+// evaluated pose, in fixed-size buffers so binding, switching animations,
+// updating and drawing never allocate. The pose is evaluated in Update (and on
+// SetAnimation); Draw only places the precomputed attachment quads. When the
+// bound data is baked, posing is skipped and Draw reads the baked table. The
+// bound SkeletonData is shared and must outlive the instance.
+class SkeletonInstance {
+public:
+    // Returns false (and stays unbound) when `data` is null or not loaded.
+    // Starts the "Idle" animation.
+    bool Bind(const SkeletonData* data);
+    bool IsBound() const { return data_ != nullptr; }
+    bool SetAnimation(const std::string& name, bool loop = true, bool restart = true);
+    bool HasAnimation(const std::string& name) const;
+    void Update(float delta_seconds);
+    // Jumps to `time` (clamped to the animation) and re-poses.
+    void Seek(float time);
+    const char* CurrentAnimation() const;
+
+    // Live placement of one slot for the current pose, offset by (x, y).
+    SkeletonSlotPlacement Place(int slot, float x, float y) const;
+
+    // Queues one quad per visible slot (rotated, mirrored when `flip_x`).
+    void Draw(RenderQueue& queue, const RenderContext& ctx, const TextureAsset& texture,
+              float x, float y, float scale, SDL_Color color, bool flip_x = false) const;
+
+private:
+    struct BoneLocal {
+        float x = 0.0f;
+        float y = 0.0f;
+        float rotation = 0.0f;
+        float scale_x = 1.0f;
+        float scale_y = 1.0f;
+    };
+
+    struct BonePose {
+        // 2x2 world matrix (no translation): [a b; c d]
+        float a = 1.0f;
+        float b = 0.0f;
+        float c = 0.0f;
+        float d = 1.0f;
+        float world_x = 0.0f;
+        float world_y = 0.0f;
+    };
+
+    const SkeletonData* data_ = nullptr;
+    int current_animation_ = -1;
+    float animation_time_ = 0.0f;
+    bool animation_loop_ = true;
+
+    std::array<BoneLocal, kMaxSkeletonBones> bones_{};
+    std::array<BonePose, kMaxSkeletonBones> poses_{};
+    std::array<int, kMaxSkeletonSlots> slot_attachments_{};
+    // Per-timeline key index for the current animation, valid up to cursor_time_.
+    std::array<int, kMaxSkeletonTimelines> cursors_{};
+    float cursor_time_ = 0.0f;
+
+    // Evaluates the current animation at animation_time_ into the buffers.
+    // No-op for baked data.
+    void Pose();
+};
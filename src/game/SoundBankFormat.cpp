@@ -0,0 +1,113 @@
+#include "SoundBankFormat.h"
+
+#include <cstring>
+
+namespace {
+// Bytes per sample frame for the SDL_AudioFormat values the mixer can open
+// with: the low byte of the format is the sample size in bits.
+std::uint32_t FrameBytes(const SoundBankHeader& header) {
+    return ((header.format & 0xff) / 8) * header.channels;
+}
+
+void AlignBlob(std::vector<unsigned char>* blob, std::size_t alignment) {
+    while (blob->size() % alignment != 0) {
+        blob->push_back(0);
+    }
+}
+
+template <typename T>
+void Patch(std::vector<unsigned char>* blob, std::size_t offset, const T& value) {
+    std::memcpy(blob->data() + offset, &value, sizeof(T));
+}
+}  // namespace
+
+int SoundBankView::FindSound(const std::string& name) const {
+    for (int i = 0; i < SoundCount(); ++i) {
+        if (name == Name(sounds[i].name)) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+bool BindSoundBank(const void* data, std::size_t size, SoundBankView* out_view) {
+    const unsigned char* base = static_cast<const unsigned char*>(data);
+    if (!base || size < sizeof(SoundBankHeader) || reinterpret_cast<std::uintptr_t>(base) % 4 != 0) {
+        return false;
+    }
+    const SoundBankHeader* header = reinterpret_cast<const SoundBankHeader*>(base);
+    if (header->magic != kSoundBankMagic || header->version != kSoundBankVersion || header->size != size) {
+        return false;
+    }
+    const std::uint32_t frame_bytes = FrameBytes(*header);
+    if (frame_bytes == 0) {
+        return false;
+    }
+    if (header->sounds_offset % 4 != 0 || header->sounds_offset > size ||
+        (size - header->sounds_offset) / sizeof(SoundBankSoundRecord) < header->sound_count ||
+        header->strings_offset > size || size - header->strings_offset < header->string_bytes) {
+        return false;
+    }
+
+    SoundBankView view;
+    view.header = header;
+    view.base = base;
+    view.sounds = reinterpret_cast<const SoundBankSoundRecord*>(base + header->sounds_offset);
+    view.strings = reinterpret_cast<const char*>(base + header->strings_offset);
+    if (header->string_bytes == 0 || view.strings[header->string_bytes - 1] != '\0') {
+        return false;
+    }
+    for (std::uint32_t i = 0; i < header->sound_count; ++i) {
+        const SoundBankSoundRecord& sound = view.sounds[i];
+        if (sound.name >= header->string_bytes || sound.data_offset % kSoundBankDataAlignment != 0 ||
+            sound.data_offset > size || size - sound.data_offset < sound.data_bytes ||
+            sound.data_bytes % frame_bytes != 0) {
+            return false;
+        }
+    }
+
+    *out_view = view;
+    return true;
+}
+
+void WriteSoundBank(std::uint32_t frequency, std::uint32_t format, std::uint32_t channels,
+                    const std::vector<SoundBankEntry>& entries, std::vector<unsigned char>* out_blob) {
+    std::vector<unsigned char>& blob = *out_blob;
+    blob.assign(sizeof(SoundBankHeader), 0);
+
+    SoundBankHeader header{};
+    header.magic = kSoundBankMagic;
+    header.version = kSoundBankVersion;
+    header.frequency = frequency;
+    header.format = format;
+    header.channels = channels;
+    header.sound_count = static_cast<std::uint32_t>(entries.size());
+
+    std::vector<SoundBankSoundRecord> records(entries.size());
+    std::string strings;
+    for (std::size_t i = 0; i < entries.size(); ++i) {
+        records[i].name = static_cast<std::uint32_t>(strings.size());
+        strings += entries[i].name;
+        strings += '\0';
+    }
+
+    AlignBlob(&blob, 4);
+    header.sounds_offset = static_cast<std::uint32_t>(blob.size());
+    blob.resize(blob.size() + records.size() * sizeof(SoundBankSoundRecord));
+    header.strings_offset = static_cast<std::uint32_t>(blob.size());
+    header.string_bytes = static_cast<std::uint32_t>(strings.size());
+    blob.insert(blob.end(), strings.begin(), strings.end());
+
+    for (std::size_t i = 0; i < entries.size(); ++i) {
+        AlignBlob(&blob, kSoundBankDataAlignment);
+        records[i].data_offset = static_cast<std::uint32_t>(blob.size());
+        records[i].data_bytes = static_cast<std::uint32_t>(entries[i].pcm.size());
+        blob.insert(blob.end(), entries[i].pcm.begin(), entries[i].pcm.end());
+    }
+
+    header.size = static_cast<std::uint32_t>(blob.size());
+    Patch(&blob, 0, header);
+    for (std::size_t i = 0; i < records.size(); ++i) {
+        Patch(&blob, header.sounds_offset + i * sizeof(SoundBankSoundRecord), records[i]);
+    }
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Pre-decoded sound bank, written by tools/SoundBankCompiler: a header, one
+// record per sound and a string table, followed by the PCM data of every sound
+// in the mixer's output format. Sample data is 16-byte aligned so it can be
+// handed to Mix_QuickLoad_RAW straight from the mapped file. Values are stored
+// little-endian.
+
+constexpr std::uint32_t kSoundBankMagic = 0x4b4e4253;  // "SBNK"
+constexpr std::uint32_t kSoundBankVersion = 1;
+constexpr std::uint32_t kSoundBankDataAlignment = 16;
+
+struct SoundBankHeader {
+    std::uint32_t magic;
+    std::uint32_t version;
+    std::uint32_t size;
+    std::uint32_t frequency;
+    std::uint32_t format;  // SDL_AudioFormat
+    std::uint32_t channels;
+    std::uint32_t sound_count;
+    std::uint32_t string_bytes;
+    std::uint32_t sounds_offset;
+    std::uint32_t strings_offset;
+};
+
+struct SoundBankSoundRecord {
+    std::uint32_t name;  // source path, as listed in ASSET_SOUNDS
+    std::uint32_t data_offset;
+    std::uint32_t data_bytes;
+};
+
+// Typed pointers into a bank blob. Does not own the memory.
+struct SoundBankView {
+    const SoundBankHeader* header = nullptr;
+    const SoundBankSoundRecord* sounds = nullptr;
+    const char* strings = nullptr;
+    const unsigned char* base = nullptr;
+
+    int SoundCount() const { return static_cast<int>(header->sound_count); }
+    const char* Name(std::uint32_t offset) const { return strings + offset; }
+    // Index of the sound decoded from `name`, or -1.
+    int FindSound(const std::string& name) const;
+    const unsigned char* Data(int index) const { return base + sounds[index].data_offset; }
+};
+
+// Checks the header and that every sound lies inside `data` and holds whole
+// sample frames, then points `out_view` into `data`. `data` must outlive the
+// view and be 4-byte aligned.
+bool BindSoundBank(const void* data, std::size_t size, SoundBankView* out_view);
+
+struct SoundBankEntry {
+    std::string name;
+    std::vector<unsigned char> pcm;
+};
+
+void WriteSoundBank(std::uint32_t frequency, std::uint32_t format, std::uint32_t channels,
+                    const std::vector<SoundBankEntry>& entries, std::vector<unsigned char>* out_blob);
@@ -0,0 +1,91 @@
+#include "VoiceManager.h"
+
+void VoiceManager::Init(bool audio_enabled) {
+    enabled_ = audio_enabled;
+    voices_.fill(Voice{});
+    triggered_.fill(-1);
+    if (enabled_) {
+        Mix_AllocateChannels(kVoiceCount);
+    }
+}
+
+void VoiceManager::Shutdown() {
+    if (enabled_) {
+        Mix_HaltChannel(-1);
+    }
+    voices_.fill(Voice{});
+    enabled_ = false;
+}
+
+int VoiceManager::Play(SoundId id, Mix_Chunk* chunk, int volume) {
+    if (!enabled_ || !chunk) {
+        return -1;
+    }
+    const int sound = static_cast<int>(id);
+    const int same_frame = triggered_[sound];
+    if (same_frame >= 0 && voices_[same_frame].sound == sound) {
+        // Several balls tossed in one frame sound like one toss; keep the
+        // loudest request.
+        if (Mix_Volume(same_frame, -1) < volume) {
+            Mix_Volume(same_frame, volume);
+        }
+        return same_frame;
+    }
+
+    RefreshVoices();
+    const int channel = PickChannel(id);
+    if (channel < 0) {
+        return -1;
+    }
+    Mix_Volume(channel, volume);
+    if (Mix_PlayChannel(channel, chunk, 0) < 0) {
+        SDL_Log("could not play sound %d: %s", sound, SDL_GetError());
+        voices_[channel] = Voice{};
+        return -1;
+    }
+    voices_[channel] = Voice{sound, SoundPolicy(id).priority, next_serial_++};
+    triggered_[sound] = channel;
+    return channel;
+}
+
+void VoiceManager::RefreshVoices() {
+    for (int channel = 0; channel < kVoiceCount; ++channel) {
+        if (voices_[channel].sound >= 0 && !Mix_Playing(channel)) {
+            voices_[channel] = Voice{};
+        }
+    }
+}
+
+int VoiceManager::PickChannel(SoundId id) const {
+    const int sound = static_cast<int>(id);
+    const SoundVoicePolicy& policy = SoundPolicy(id);
+
+    int copies = 0;
+    int oldest_copy = -1;
+    int free_channel = -1;
+    int victim = -1;
+    for (int channel = 0; channel < kVoiceCount; ++channel) {
+        const Voice& voice = voices_[channel];
+        if (voice.sound < 0) {
+            if (free_channel < 0) {
+                free_channel = channel;
+            }
+            continue;
+        }
+        if (voice.sound == sound) {
+            copies++;
+            if (oldest_copy < 0 || voice.serial < voices_[oldest_copy].serial) {
+                oldest_copy = channel;
+            }
+        }
+        if (voice.priority <= policy.priority &&
+            (victim < 0 || voice.priority < voices_[victim].priority ||
+             (voice.priority == voices_[victim].priority && voice.serial < voices_[victim].serial))) {
+            victim = channel;
+        }
+    }
+    if (copies >= policy.max_voices) {
+        return oldest_copy;
+    }
+    return free_channel >= 0 ? free_channel : victim;
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <SDL2/SDL_mixer.h>
+#include <array>
+#include <cstdint>
+
+#include "AssetIds.h"
+
+// Assigns mixer channels to sound effects. Every sound has a cap on how many
+// copies play at once and a priority (see ASSET_SOUNDS). A new sound takes a
+// free channel, or replaces the oldest copy of itself when at its cap, or
+// steals the channel of the oldest lower-or-equal priority voice; it is only
+// dropped when every channel holds something more important. Repeated triggers
+// of one sound within a frame start a single voice. Volume is set per channel,
+// so shared chunks are never modified.
+class VoiceManager {
+public:
+    static constexpr int kVoiceCount = 8;
+
+    // Allocates the mixer channels. Without audio every Play is a no-op.
+    void Init(bool audio_enabled);
+    void Shutdown();
+
+    // Starts a frame's trigger window; called once per rendered frame.
+    void BeginFrame() { triggered_.fill(-1); }
+    // Returns the channel the sound plays on, or -1 when it was dropped.
+    int Play(SoundId id, Mix_Chunk* chunk, int volume);
+
+private:
+    struct Voice {
+        int sound = -1;  // SoundId, -1 when idle
+        int priority = 0;
+        std::uint32_t serial = 0;  // start order; lower is older
+    };
+
+    bool enabled_ = false;
+    std::array<Voice, kVoiceCount> voices_{};
+    std::uint32_t next_serial_ = 0;
+    // Channel each sound started on this frame, -1 if not triggered yet.
+    std::array<int, kSoundCount> triggered_{};
+
+    void RefreshVoices();
+    int PickChannel(SoundId id) const;
+};
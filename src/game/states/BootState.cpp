@@ -22,5 +22,6 @@ void BootState::Update(Game& game, float delta_seconds) {
 }
 
 void BootState::Render(Game& game) {
-    (void)game;
+    SDL_SetRenderDrawColor(game.Renderer(), 0, 0, 0, 255);
+    SDL_RenderClear(game.Renderer());
 }
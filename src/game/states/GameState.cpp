@@ -3,12 +3,14 @@
 #include <algorithm>
 #include <cmath>
 #include <cstdio>
-#include <random>
 #include <string>
 
 #include "game/Assets.h"
+#include "game/Collision.h"
 #include "game/Game.h"
 #include "game/MathUtils.h"
+#include "game/Profiler.h"
+#include "game/Random.h"
 #include "game/RenderHelpers.h"
 #include "game/states/MenuState.h"
 
@@ -25,24 +27,18 @@ constexpr float kMoveThreshold = 1.0f;
 constexpr float kGroundContactY = kGroundY + kGroundOffset;
 constexpr float kHeroVisualYOffset = 0.0f;
 constexpr float kResultOverlayDelay = 2.0f;
+// Broadphase covers the spawn margins around the 1216x800 design space;
+// cells are a little larger than a ball.
+constexpr SDL_FRect kCollisionBounds{-256.0f, -256.0f, 1216.0f + 512.0f, 800.0f + 512.0f};
+constexpr float kCollisionCellSize = 128.0f;
+constexpr std::uint32_t kCollideBall = 1u << 0;
+constexpr std::uint32_t kCollideNumber = 1u << 1;
 
 const char* kRunAnimations[] = {"Run0", "Run1", "Run2", "Run3", "RunSmile"};
 const char* kIdleAnimations[] = {"Idle", "IdleSmile"};
 
-float RandomRange(float min_value, float max_value) {
-    static std::mt19937 rng{static_cast<unsigned int>(SDL_GetTicks())};
-    std::uniform_real_distribution<float> dist(min_value, max_value);
-    return dist(rng);
-}
-
-int RandomInt(int min_value, int max_value) {
-    static std::mt19937 rng{static_cast<unsigned int>(SDL_GetTicks())};
-    std::uniform_int_distribution<int> dist(min_value, max_value);
-    return dist(rng);
-}
-
-bool RectOverlap(const SDL_FRect& a, const SDL_FRect& b) {
-    return !(a.x > b.x + b.w || a.x + a.w < b.x || a.y > b.y + b.h || a.y + a.h < b.y);
+SDL_FPoint Interpolate(const SDL_FPoint& previous, const SDL_FPoint& current, float alpha) {
+    return SDL_FPoint{Lerp(previous.x, current.x, alpha), Lerp(previous.y, current.y, alpha)};
 }
 
 std::string PickRandomAnimation(const char* const* options, int count) {
@@ -59,10 +55,80 @@ SDL_Color RandomColor() {
 }
 }
 
+int GameState::BallPool::Add() {
+    const int i = index.Add();
+    if (i >= 0) {
+        pos_x[i] = pos_y[i] = prev_x[i] = prev_y[i] = 0.0f;
+        vel_x[i] = vel_y[i] = 0.0f;
+        radius[i] = 0.0f;
+        scale[i] = 1.0f;
+        bounce_t[i] = 1.0f;
+        texture_index[i] = 0;
+    }
+    return i;
+}
+
+void GameState::BallPool::Remove(int i) {
+    const int moved = index.Remove(i);
+    if (moved < 0) {
+        return;
+    }
+    pos_x[i] = pos_x[moved];
+    pos_y[i] = pos_y[moved];
+    prev_x[i] = prev_x[moved];
+    prev_y[i] = prev_y[moved];
+    vel_x[i] = vel_x[moved];
+    vel_y[i] = vel_y[moved];
+    radius[i] = radius[moved];
+    scale[i] = scale[moved];
+    bounce_t[i] = bounce_t[moved];
+    texture_index[i] = texture_index[moved];
+}
+
+int GameState::NumberPool::Add() {
+    const int i = index.Add();
+    if (i >= 0) {
+        pos_x[i] = pos_y[i] = prev_x[i] = prev_y[i] = 0.0f;
+        vel_x[i] = vel_y[i] = 0.0f;
+        flash_timer[i] = 0.0f;
+        angle[i] = 0.0f;
+        tint[i] = SDL_Color{255, 255, 255, 255};
+        value[i] = 1;
+        collecting[i] = 0;
+    }
+    return i;
+}
+
+void GameState::NumberPool::Remove(int i) {
+    const int moved = index.Remove(i);
+    if (moved < 0) {
+        return;
+    }
+    pos_x[i] = pos_x[moved];
+    pos_y[i] = pos_y[moved];
+    prev_x[i] = prev_x[moved];
+    prev_y[i] = prev_y[moved];
+    vel_x[i] = vel_x[moved];
+    vel_y[i] = vel_y[moved];
+    flash_timer[i] = flash_timer[moved];
+    angle[i] = angle[moved];
+    tint[i] = tint[moved];
+    value[i] = value[moved];
+    collecting[i] = collecting[moved];
+}
+
 GameState::GameState(int best_score, int land_index)
-    : best_score_(best_score), land_index_(land_index) {}
+    : best_score_(best_score),
+      land_index_(land_index),
+      collision_grid_(kCollisionBounds, kCollisionCellSize, BallPool::kCapacity + NumberPool::kCapacity) {}
 
 void GameState::Enter(Game& game) {
+    // First: it may reseed the RNG everything below draws from.
+    game.Replay().BeginRun(game.Config(), best_score_, land_index_);
+    // Death effects too: loading them when the hero dies would hitch the
+    // frame the blood appears.
+    game.GetAssets().Prefetch(TextureSet::kGameplay);
+    game.GetAssets().Prefetch(TextureSet::kDeath);
     elapsed_ = 0.0f;
     ball_timer_ = 0.0f;
     number_timer_ = 0.0f;
@@ -90,17 +156,19 @@ void GameState::Enter(Game& game) {
     effect_blood_timer_ = 0.0f;
     red_border_timer_ = 0.0f;
     shake_timer_ = 0.0f;
+    shake_offset_ = SDL_FPoint{0.0f, 0.0f};
 
-    balls_.clear();
-    numbers_.clear();
-    blood_particles_.clear();
-    dead_parts_.clear();
+    balls_.Clear();
+    numbers_.Clear();
+    collision_grid_.Clear();
+    particles_.Clear();
+    particle_density_ = game.Config().particle_density;
 
     ResetHero();
     UpdateGauge();
 
     if (!stickman_loaded_) {
-        stickman_loaded_ = stickman_.Load("assets/Stickman.json", "assets/Stickman.atlas");
+        stickman_loaded_ = stickman_.Bind(game.GetAssets().GetSkeleton(SkeletonId::kStickman));
     }
     was_moving_ = false;
     hero_animation_ = "Idle";
@@ -111,7 +179,9 @@ void GameState::Enter(Game& game) {
 }
 
 void GameState::Exit(Game& game) {
-    (void)game;
+    game.Replay().EndRun(gauge_count_);
+    game.GetAssets().Release(TextureSet::kGameplay);
+    game.GetAssets().Release(TextureSet::kDeath);
 }
 
 void GameState::HandleEvent(Game& game, const SDL_Event& event) {
@@ -120,17 +190,17 @@ void GameState::HandleEvent(Game& game, const SDL_Event& event) {
             const SDL_FPoint pos = game.RenderCtx().ScreenToWorld(event.button.x, event.button.y);
             if (IsInsideButton(result_gamecenter_, pos.x, pos.y)) {
                 result_gamecenter_.pressed = true;
-                game.GetAssets().PlaySound("uiButton", MIX_MAX_VOLUME / 2);
+                game.GetAssets().PlaySound(SoundId::kUiButton, MIX_MAX_VOLUME / 2);
                 return;
             }
             if (IsInsideButton(result_share_, pos.x, pos.y)) {
                 result_share_.pressed = true;
-                game.GetAssets().PlaySound("uiButton", MIX_MAX_VOLUME / 2);
+                game.GetAssets().PlaySound(SoundId::kUiButton, MIX_MAX_VOLUME / 2);
                 return;
             }
             if (IsInsideButton(result_play_, pos.x, pos.y)) {
                 result_play_.pressed = true;
-                game.GetAssets().PlaySound("uiButton", MIX_MAX_VOLUME / 2);
+                game.GetAssets().PlaySound(SoundId::kUiButton, MIX_MAX_VOLUME / 2);
                 return;
             }
             return;
@@ -171,6 +241,7 @@ void GameState::HandleEvent(Game& game, const SDL_Event& event) {
 
 void GameState::Update(Game& game, float delta_seconds) {
     elapsed_ += delta_seconds;
+    StorePreviousPositions();
 
     if (!dead_) {
         HandleInput(game, delta_seconds);
@@ -193,18 +264,7 @@ void GameState::Update(Game& game, float delta_seconds) {
         UpdateParticles(delta_seconds);
 
         CheckCollisions(game);
-
-        ball_timer_ += delta_seconds;
-        if (ball_timer_ >= 1.0f) {
-            ball_timer_ = 0.0f;
-            SpawnBall(game);
-        }
-
-        number_timer_ += delta_seconds;
-        if (number_timer_ >= 5.0f) {
-            number_timer_ = 0.0f;
-            SpawnNumber(game);
-        }
+        UpdateSpawners(game, delta_seconds);
 
         gauge_timer_ += delta_seconds;
         if (gauge_timer_ >= 0.1f) {
@@ -257,6 +317,9 @@ void GameState::Update(Game& game, float delta_seconds) {
         }
         if (shake_timer_ > 0.0f) {
             shake_timer_ -= delta_seconds;
+            shake_offset_ = SDL_FPoint{RandomRange(-10.0f, 10.0f), RandomRange(-10.0f, 10.0f)};
+        } else {
+            shake_offset_ = SDL_FPoint{0.0f, 0.0f};
         }
         if (red_border_timer_ > 0.0f) {
             red_border_timer_ -= delta_seconds;
@@ -270,87 +333,107 @@ void GameState::Update(Game& game, float delta_seconds) {
 
 void GameState::Render(Game& game) {
     SDL_Renderer* renderer = game.Renderer();
+    RenderQueue& queue = game.Queue();
     RenderContext ctx = game.RenderCtx();
+    const float alpha = game.RenderAlpha();
 
-    float shake_x = 0.0f;
-    float shake_y = 0.0f;
-    if (shake_timer_ > 0.0f) {
-        shake_x = RandomRange(-10.0f, 10.0f);
-        shake_y = RandomRange(-10.0f, 10.0f);
-    }
-    ctx.offset_x += static_cast<int>(shake_x * ctx.scale);
-    ctx.offset_y += static_cast<int>(shake_y * ctx.scale);
+    const SDL_Point shake{static_cast<int>(shake_offset_.x * ctx.scale), static_cast<int>(shake_offset_.y * ctx.scale)};
+    ctx.offset_x += shake.x;
+    ctx.offset_y += shake.y;
 
     SDL_SetRenderDrawColor(renderer, 255, 255, 255, 255);
     SDL_RenderClear(renderer);
 
-    Assets& assets = game.GetAssets();
-    DrawTexture(renderer, ctx, assets.GetTexture("bg"), 0.0f, 0.0f, 1.0f, 1.0f, SDL_Color{255, 255, 255, 255});
+    const Assets& assets = game.GetAssets();
+    RenderBackground(game, shake);
+    queue.SetLayer(RenderLayer::kWorld);
+    RenderBalls(queue, ctx, assets, alpha);
+    RenderNumbers(queue, ctx, assets, alpha);
+    RenderHero(queue, ctx, assets, alpha);
+    RenderParticles(queue, ctx, assets, alpha);
+    queue.SetLayer(RenderLayer::kHud);
+    RenderHud(queue, ctx, assets);
 
-    const std::string land_key = floor_flashing_ ? "landWhite" : ("land" + std::to_string(land_index_));
+    if (result_overlay_active_) {
+        RenderResultOverlay(game, ctx);
+    }
+}
+
+void GameState::RenderBackground(Game& game, SDL_Point shake) const {
+    PROFILE_SCOPE(ProfileZone::kRenderBackground);
+    const TextureId land_texture = floor_flashing_ ? TextureId::kLandWhite : TextureFrame(TextureId::kLand0, land_index_);
     SDL_Color land_tint = {255, 255, 255, 255};
     if (floor_flashing_) {
         land_tint = floor_flash_tint_;
     }
-    DrawTexture(renderer, ctx, assets.GetTexture(land_key), 0.0f, kGroundY, 1.0f, 1.0f, land_tint);
+    game.Background().Draw(game.Renderer(), game.RenderCtx(), game.GetAssets(), land_texture, land_tint, shake.x,
+                           shake.y);
+}
 
-    for (const auto& ball : balls_) {
-        if (!ball.alive) {
-            continue;
-        }
-        const TextureAsset asset = assets.GetTexture("ball" + std::to_string(ball.texture_index));
-        DrawTextureCentered(renderer, ctx, asset, ball.pos.x, ball.pos.y, ball.scale, ball.scale, SDL_Color{255, 255, 255, 255});
+void GameState::RenderBalls(RenderQueue& queue, const RenderContext& ctx, const Assets& assets, float alpha) const {
+    PROFILE_SCOPE(ProfileZone::kRenderBalls);
+    const TextureAsset& shadow = assets.GetTexture(TextureId::kShadow);
+    for (int i = 0; i < balls_.Size(); ++i) {
+        const SDL_FPoint pos = Interpolate(SDL_FPoint{balls_.prev_x[i], balls_.prev_y[i]},
+                                           SDL_FPoint{balls_.pos_x[i], balls_.pos_y[i]}, alpha);
+        const float scale = balls_.scale[i];
+        const TextureAsset& asset = assets.GetTexture(TextureFrame(TextureId::kBall0, balls_.texture_index[i]));
+        DrawTextureCentered(queue, ctx, asset, pos.x, pos.y, scale, scale, SDL_Color{255, 255, 255, 255});
 
-        const TextureAsset shadow = assets.GetTexture("shadow");
         const float shadow_ground_y = kGroundContactY;
-        float shadow_scale = 0.5f + (ball.pos.y / shadow_ground_y) / 2.0f;
-        float shadow_alpha = 0.5f + (ball.pos.y / shadow_ground_y) / 2.0f;
-        DrawTextureCentered(renderer, ctx, shadow, ball.pos.x, shadow_ground_y, shadow_scale, shadow_scale, SDL_Color{255, 255, 255, 255}, shadow_alpha);
+        float shadow_scale = 0.5f + (pos.y / shadow_ground_y) / 2.0f;
+        float shadow_alpha = 0.5f + (pos.y / shadow_ground_y) / 2.0f;
+        DrawTextureCentered(queue, ctx, shadow, pos.x, shadow_ground_y, shadow_scale, shadow_scale, SDL_Color{255, 255, 255, 255}, shadow_alpha);
     }
+}
 
-    for (const auto& number : numbers_) {
-        if (!number.alive) {
-            continue;
-        }
-        const TextureAsset asset = assets.GetTexture("numberItem" + std::to_string(number.value));
-        DrawTextureCentered(renderer, ctx, asset, number.pos.x, number.pos.y, 1.0f, 1.0f, number.tint);
+void GameState::RenderNumbers(RenderQueue& queue, const RenderContext& ctx, const Assets& assets, float alpha) const {
+    PROFILE_SCOPE(ProfileZone::kRenderNumbers);
+    for (int i = 0; i < numbers_.Size(); ++i) {
+        const SDL_FPoint pos = Interpolate(SDL_FPoint{numbers_.prev_x[i], numbers_.prev_y[i]},
+                                           SDL_FPoint{numbers_.pos_x[i], numbers_.pos_y[i]}, alpha);
+        const TextureAsset& asset = assets.GetTexture(TextureFrame(TextureId::kNumberItem1, numbers_.value[i] - 1));
+        DrawTextureCentered(queue, ctx, asset, pos.x, pos.y, 1.0f, 1.0f, numbers_.tint[i]);
     }
+}
 
-    if (hero_.alive) {
-        if (stickman_loaded_) {
-            stickman_.Draw(renderer, ctx, assets.GetTexture("stickman"), hero_.pos.x, hero_.pos.y + kHeroVisualYOffset, 1.5f,
-                           SDL_Color{255, 255, 255, 255}, hero_facing_left_);
-        } else {
-            DrawTextureCentered(renderer, ctx, assets.GetTexture("stickman"), hero_.pos.x, hero_.pos.y, 1.5f, 1.5f, SDL_Color{255, 255, 255, 255});
-        }
-        DrawTextureCentered(renderer, ctx, assets.GetTexture("shadow"), hero_.pos.x, hero_.pos.y + 20.0f + kHeroVisualYOffset, 1.0f, 1.0f, SDL_Color{255, 255, 255, 255});
+void GameState::RenderHero(RenderQueue& queue, const RenderContext& ctx, const Assets& assets, float alpha) const {
+    PROFILE_SCOPE(ProfileZone::kRenderStickman);
+    if (!hero_.alive) {
+        return;
     }
-
-    for (const auto& particle : blood_particles_) {
-        const TextureAsset asset = assets.GetTexture("blood");
-        DrawTextureCentered(renderer, ctx, asset, particle.pos.x, particle.pos.y, particle.scale, particle.scale, particle.color);
+    const SDL_FPoint hero_pos = Interpolate(hero_.prev_pos, hero_.pos, alpha);
+    if (stickman_loaded_) {
+        stickman_.Draw(queue, ctx, assets.GetTexture(TextureId::kStickman), hero_pos.x, hero_pos.y + kHeroVisualYOffset, 1.5f,
+                       SDL_Color{255, 255, 255, 255}, hero_facing_left_);
+    } else {
+        DrawTextureCentered(queue, ctx, assets.GetTexture(TextureId::kStickman), hero_pos.x, hero_pos.y, 1.5f, 1.5f, SDL_Color{255, 255, 255, 255});
     }
+    DrawTextureCentered(queue, ctx, assets.GetTexture(TextureId::kShadow), hero_pos.x, hero_pos.y + 20.0f + kHeroVisualYOffset, 1.0f, 1.0f, SDL_Color{255, 255, 255, 255});
+}
 
-    for (const auto& part : dead_parts_) {
-        const TextureAsset asset = assets.GetTexture("deadParts" + std::to_string(part.texture_index));
-        DrawTextureCentered(renderer, ctx, asset, part.pos.x, part.pos.y, part.scale, part.scale, part.color);
-    }
+void GameState::RenderParticles(RenderQueue& queue, const RenderContext& ctx, const Assets& assets, float alpha) const {
+    PROFILE_SCOPE(ProfileZone::kRenderParticles);
+    particles_.Draw(queue, ctx, assets, alpha);
 
     if (effect_blood_frame_ >= 0) {
-        const TextureAsset asset = assets.GetTexture("effectBlood" + std::to_string(effect_blood_frame_));
-        DrawTextureCentered(renderer, ctx, asset, hero_.pos.x, hero_.pos.y - 45.0f, 1.0f, 1.0f, SDL_Color{255, 255, 255, 255});
+        const TextureAsset& asset = assets.GetTexture(TextureFrame(TextureId::kEffectBlood0, effect_blood_frame_));
+        DrawTextureCentered(queue, ctx, asset, hero_.pos.x, hero_.pos.y - 45.0f, 1.0f, 1.0f, SDL_Color{255, 255, 255, 255});
     }
+}
 
-    const TextureAsset gauge = assets.GetTexture("gauge");
-    const TextureAsset gauge_head = assets.GetTexture("gaugeHead");
+void GameState::RenderHud(RenderQueue& queue, const RenderContext& ctx, const Assets& assets) const {
+    PROFILE_SCOPE(ProfileZone::kRenderHud);
+    const TextureAsset gauge = assets.GetTexture(TextureId::kGauge);
+    const TextureAsset gauge_head = assets.GetTexture(TextureId::kGaugeHead);
 
     const float gauge_scale = 1216.0f / static_cast<float>(gauge.width);
     const int crop_width = std::min(gauge.width, static_cast<int>(gauge_head_x_ / gauge_scale));
     SDL_Rect src{0, 0, crop_width, gauge.height};
-    DrawTextureSubrect(renderer, ctx, gauge, src, 0.0f, 0.0f, gauge_scale, 1.0f, gauge_tint_);
-    DrawTexture(renderer, ctx, gauge_head, gauge_head_x_ - 10.0f, 0.0f, 1.0f, 1.0f, gauge_head_tint_);
+    DrawTextureSubrect(queue, ctx, gauge, src, 0.0f, 0.0f, gauge_scale, 1.0f, gauge_tint_);
+    DrawTexture(queue, ctx, gauge_head, gauge_head_x_ - 10.0f, 0.0f, 1.0f, 1.0f, gauge_head_tint_);
 
-    const BitmapFont* time_font = assets.GetFont("numberTime");
+    const BitmapFont* time_font = assets.GetFont(FontId::kNumberTime);
     if (time_font) {
         const int integer = gauge_count_ / 10;
         const float fractional = ClampFloat(gauge_timer_ / 0.1f, 0.0f, 0.999f);
@@ -358,44 +441,58 @@ void GameState::Render(Game& game) {
         const int decimal_two = (gauge_count_ % 10) * 10 + hundredth;
         char decimal_text[3];
         std::snprintf(decimal_text, sizeof(decimal_text), "%02d", decimal_two);
+        char integer_text[12];
+        std::snprintf(integer_text, sizeof(integer_text), "%d", integer);
         int integer_width = 0;
         const float time_y = static_cast<float>(gauge_head.height);
-        time_font->Draw(renderer, ctx, std::to_string(integer), gauge_head_x_ - 30.0f, time_y, 1.0f, SDL_Color{0, 0, 0, 255}, &integer_width);
-        const TextureAsset dot = assets.GetTexture("white4");
-        DrawTexture(renderer, ctx, dot, gauge_head_x_ - 30.0f + static_cast<float>(integer_width) + 2.0f,
+        TextBatch text(queue, time_font);
+        text.Add(ctx, integer_text, gauge_head_x_ - 30.0f, time_y, 1.0f, SDL_Color{0, 0, 0, 255}, &integer_width);
+        const TextureAsset dot = assets.GetTexture(TextureId::kWhite4);
+        DrawTexture(queue, ctx, dot, gauge_head_x_ - 30.0f + static_cast<float>(integer_width) + 2.0f,
                     time_y + static_cast<float>(time_font->LineHeight()) - 5.0f, 1.0f, 1.0f, SDL_Color{0, 0, 0, 255});
-        time_font->Draw(renderer, ctx, decimal_text, gauge_head_x_ - 30.0f + static_cast<float>(integer_width) + 2.0f + static_cast<float>(dot.width),
-                        time_y, 1.0f, SDL_Color{0, 0, 0, 255});
+        text.Add(ctx, decimal_text, gauge_head_x_ - 30.0f + static_cast<float>(integer_width) + 2.0f + static_cast<float>(dot.width),
+                 time_y, 1.0f, SDL_Color{0, 0, 0, 255});
     }
 
     if (red_border_timer_ > 0.0f) {
-        const TextureAsset hit = assets.GetTexture("effectHit");
-        DrawTexture(renderer, ctx, hit, 0.0f, 0.0f, 1216.0f / static_cast<float>(hit.width), 800.0f / static_cast<float>(hit.height),
+        const TextureAsset hit = assets.GetTexture(TextureId::kEffectHit);
+        DrawTexture(queue, ctx, hit, 0.0f, 0.0f, 1216.0f / static_cast<float>(hit.width), 800.0f / static_cast<float>(hit.height),
                     SDL_Color{255, 255, 255, 255}, 0.8f);
     }
-
-    if (result_overlay_active_) {
-        RenderResultOverlay(game, ctx);
-    }
-
-    SDL_RenderPresent(renderer);
 }
 
 void GameState::ResetHero() {
     hero_.pos = SDL_FPoint{1216.0f / 2.0f, kGroundContactY};
+    hero_.prev_pos = hero_.pos;
     hero_.velocity = SDL_FPoint{0.0f, 0.0f};
     hero_.dir = 0.0f;
     hero_.alive = true;
 }
 
+void GameState::StorePreviousPositions() {
+    hero_.prev_pos = hero_.pos;
+    std::copy_n(balls_.pos_x.begin(), balls_.Size(), balls_.prev_x.begin());
+    std::copy_n(balls_.pos_y.begin(), balls_.Size(), balls_.prev_y.begin());
+    std::copy_n(numbers_.pos_x.begin(), numbers_.Size(), numbers_.prev_x.begin());
+    std::copy_n(numbers_.pos_y.begin(), numbers_.Size(), numbers_.prev_y.begin());
+}
+
 void GameState::HandleInput(Game& game, float delta_seconds) {
     (void)delta_seconds;
     const Uint8* keys = SDL_GetKeyboardState(nullptr);
-    float dir = 0.0f;
+    std::uint8_t live = 0;
     if (keys[SDL_SCANCODE_LEFT] || keys[SDL_SCANCODE_A]) {
-        dir -= 1.0f;
+        live |= kReplayKeyLeft;
     }
     if (keys[SDL_SCANCODE_RIGHT] || keys[SDL_SCANCODE_D]) {
+        live |= kReplayKeyRight;
+    }
+    const std::uint8_t held = game.Replay().Keys(live);
+    float dir = 0.0f;
+    if (held & kReplayKeyLeft) {
+        dir -= 1.0f;
+    }
+    if (held & kReplayKeyRight) {
         dir += 1.0f;
     }
     if (mouse_down_) {
@@ -411,119 +508,230 @@ void GameState::HandleInput(Game& game, float delta_seconds) {
 }
 
 void GameState::UpdateHero(float delta_seconds) {
+    PROFILE_SCOPE(ProfileZone::kUpdateHero);
     hero_.pos.x += hero_.velocity.x * delta_seconds;
     hero_.pos.x = ClampFloat(hero_.pos.x, 0.0f, 1216.0f);
 }
 
 void GameState::UpdateBalls(float delta_seconds) {
-    const SDL_FRect ground = LandRect();
-    for (auto& ball : balls_) {
-        if (!ball.alive) {
-            continue;
-        }
-        ball.velocity.y += kGravity * delta_seconds;
-        ball.pos.x += ball.velocity.x * delta_seconds;
-        ball.pos.y += ball.velocity.y * delta_seconds;
-
-        // Match JS collider top: land body has y-offset +20 from land sprite top.
-        const float ground_y = ground.y + kGroundOffset;
-        if (ball.pos.y + ball.radius >= ground_y) {
-            ball.pos.y = ground_y - ball.radius;
-            ball.velocity.y = -std::abs(ball.velocity.y);
+    PROFILE_SCOPE(ProfileZone::kUpdateBalls);
+    // Match JS collider top: land body has y-offset +20 from land sprite top.
+    const float ground_y = LandRect().y + kGroundOffset;
+    const int count = balls_.Size();
+    float* pos_x = balls_.pos_x.data();
+    float* pos_y = balls_.pos_y.data();
+    float* vel_x = balls_.vel_x.data();
+    float* vel_y = balls_.vel_y.data();
+    const float* radius = balls_.radius.data();
+    float* bounce_t = balls_.bounce_t.data();
+    for (int i = 0; i < count; ++i) {
+        vel_y[i] += kGravity * delta_seconds;
+        pos_x[i] += vel_x[i] * delta_seconds;
+        const float start_y = pos_y[i];
+        pos_y[i] += vel_y[i] * delta_seconds;
+        bounce_t[i] = 1.0f;
+        const float contact_y = ground_y - radius[i];
+        if (pos_y[i] >= contact_y) {
+            // Bounce at the time of impact and carry the rest of the step
+            // upwards, so the bounce height doesn't depend on the tick rate.
+            if (start_y < contact_y) {
+                bounce_t[i] = (contact_y - start_y) / (pos_y[i] - start_y);
+                pos_y[i] = contact_y - (pos_y[i] - contact_y);
+            } else {
+                bounce_t[i] = 0.0f;
+                pos_y[i] = contact_y;
+            }
+            vel_y[i] = -std::abs(vel_y[i]);
         }
-
-        if (ball.pos.x < -200.0f || ball.pos.x > 1216.0f + 200.0f) {
-            ball.alive = false;
+    }
+    for (int i = count - 1; i >= 0; --i) {
+        if (pos_x[i] < -200.0f || pos_x[i] > 1216.0f + 200.0f) {
+            RemoveBall(i);
         }
     }
-    balls_.erase(std::remove_if(balls_.begin(), balls_.end(), [](const Ball& ball) { return !ball.alive; }), balls_.end());
 }
 
 void GameState::UpdateNumbers(Game& game, float delta_seconds) {
-    for (auto& number : numbers_) {
-        if (!number.alive) {
-            continue;
-        }
-        if (!number.collecting) {
-            number.velocity.y += kNumberGravity * delta_seconds;
-            number.pos.x += number.velocity.x * delta_seconds;
-            number.pos.y += number.velocity.y * delta_seconds;
-            number.flash_timer -= delta_seconds;
-            if (number.flash_timer <= 0.0f) {
-                number.flash_timer += 0.2f;
-                number.tint = RandomColor();
+    PROFILE_SCOPE(ProfileZone::kUpdateNumbers);
+    // Backwards: a collected number is swap-removed, and the one moved into
+    // its place has already been updated.
+    for (int i = numbers_.Size() - 1; i >= 0; --i) {
+        float& pos_x = numbers_.pos_x[i];
+        float& pos_y = numbers_.pos_y[i];
+        if (!numbers_.collecting[i]) {
+            numbers_.vel_y[i] += kNumberGravity * delta_seconds;
+            pos_x += numbers_.vel_x[i] * delta_seconds;
+            pos_y += numbers_.vel_y[i] * delta_seconds;
+            numbers_.flash_timer[i] -= delta_seconds;
+            if (numbers_.flash_timer[i] <= 0.0f) {
+                numbers_.flash_timer[i] += 0.2f;
+                numbers_.tint[i] = RandomColor();
             }
             const float number_ground_y = kGroundContactY;
-            if (number.pos.y > number_ground_y) {
-                number.pos.y = number_ground_y;
-                number.velocity.y = -number.velocity.y * 0.2f;
+            if (pos_y > number_ground_y) {
+                pos_y = number_ground_y;
+                numbers_.vel_y[i] = -numbers_.vel_y[i] * 0.2f;
             }
         } else {
-            const float dx = gauge_head_x_ - number.pos.x;
-            const float dy = 10.0f - number.pos.y;
+            const float dx = gauge_head_x_ - pos_x;
+            const float dy = 10.0f - pos_y;
             const float dist = std::sqrt(dx * dx + dy * dy);
             const float speed = 1000.0f;
             if (dist < 5.0f) {
-                number.alive = false;
-                gauge_count_ += number.value * 10;
+                gauge_count_ += numbers_.value[i] * 10;
+                RemoveNumber(i);
                 UpdateGauge();
                 gauge_flash_ticks_ = 10;
                 gauge_tint_ = RandomColor();
-                game.GetAssets().PlaySound("numberGet", MIX_MAX_VOLUME / 2);
+                game.GetAssets().PlaySound(SoundId::kNumberGet, MIX_MAX_VOLUME / 2);
             } else {
                 const float inv_dist = 1.0f / dist;
-                number.pos.x += dx * inv_dist * speed * delta_seconds;
-                number.pos.y += dy * inv_dist * speed * delta_seconds;
+                pos_x += dx * inv_dist * speed * delta_seconds;
+                pos_y += dy * inv_dist * speed * delta_seconds;
             }
         }
     }
-    numbers_.erase(std::remove_if(numbers_.begin(), numbers_.end(), [](const NumberItem& item) { return !item.alive; }), numbers_.end());
 }
 
 void GameState::UpdateParticles(float delta_seconds) {
-    for (auto& particle : blood_particles_) {
-        particle.life -= delta_seconds;
-        particle.velocity.y += kGravity * delta_seconds;
-        particle.pos.x += particle.velocity.x * delta_seconds;
-        particle.pos.y += particle.velocity.y * delta_seconds;
-    }
-    blood_particles_.erase(std::remove_if(blood_particles_.begin(), blood_particles_.end(),
-                                          [](const Particle& p) { return p.life <= 0.0f; }),
-                           blood_particles_.end());
-
-    for (auto& part : dead_parts_) {
-        part.life -= delta_seconds;
-        part.velocity.y += kGravity * delta_seconds;
-        part.pos.x += part.velocity.x * delta_seconds;
-        part.pos.y += part.velocity.y * delta_seconds;
-    }
-    dead_parts_.erase(std::remove_if(dead_parts_.begin(), dead_parts_.end(),
-                                     [](const Particle& p) { return p.life <= 0.0f; }),
-                      dead_parts_.end());
+    PROFILE_SCOPE(ProfileZone::kUpdateParticles);
+    // Also stores the particles' previous positions.
+    particles_.Update(delta_seconds);
 }
 
 void GameState::CheckCollisions(Game& game) {
+    PROFILE_SCOPE(ProfileZone::kCollisions);
     if (!hero_.alive) {
         return;
     }
-    const SDL_FRect hero_rect = HeroRect();
-    for (auto& ball : balls_) {
-        if (!ball.alive) {
-            continue;
+    SyncCollisionGrid();
+    // Grid boxes cover each body's whole path this tick, so fast movers and
+    // long ticks can't skip past the hero between two samples; candidates
+    // then get the exact swept test.
+    const SDL_FRect hero_box = UnionRect(HeroPrevRect(), HeroRect());
+    float impact_t = 1.0f;
+    int impact_ball = -1;
+    collision_grid_.Query(hero_box, kCollideBall, [this, &impact_t, &impact_ball](int id) {
+        const int i = balls_.index.IndexOfSlot(static_cast<std::uint32_t>(id));
+        float t = 0.0f;
+        if (SweepBallHero(i, &t) && (impact_ball < 0 || t < impact_t)) {
+            impact_t = t;
+            impact_ball = i;
         }
-        SDL_FRect ball_rect{ball.pos.x - ball.radius, ball.pos.y - ball.radius, ball.radius * 2.0f, ball.radius * 2.0f};
-        if (RectOverlap(hero_rect, ball_rect)) {
-            OnDeath(game);
-            return;
+        return true;
+    });
+    if (impact_ball >= 0) {
+        // Freeze the hero and the ball at first contact rather than wherever
+        // the end of the tick left them.
+        hero_.pos.x = Lerp(hero_.prev_pos.x, hero_.pos.x, impact_t);
+        const SDL_FPoint contact = BallPositionAt(impact_ball, impact_t);
+        balls_.pos_x[impact_ball] = contact.x;
+        balls_.pos_y[impact_ball] = contact.y;
+        OnDeath(game);
+        return;
+    }
+    const SDL_FRect hero_prev = HeroPrevRect();
+    const SDL_FPoint hero_delta{hero_.pos.x - hero_.prev_pos.x, hero_.pos.y - hero_.prev_pos.y};
+    collision_grid_.Query(hero_box, kCollideNumber, [this, &hero_prev, hero_delta](int id) {
+        const int i = numbers_.index.IndexOfSlot(static_cast<std::uint32_t>(id - BallPool::kCapacity));
+        // Numbers keep their square 40x40 pickup box: a point swept against
+        // the hero grown by half the box.
+        const SDL_FRect grown{hero_prev.x - 20.0f, hero_prev.y - 20.0f, hero_prev.w + 40.0f, hero_prev.h + 40.0f};
+        const SDL_FPoint start{numbers_.prev_x[i], numbers_.prev_y[i]};
+        const SDL_FPoint delta{numbers_.pos_x[i] - start.x - hero_delta.x, numbers_.pos_y[i] - start.y - hero_delta.y};
+        float t = 0.0f;
+        if (SweepCircleRect(start, delta, 0.0f, grown, &t)) {
+            numbers_.collecting[i] = 1;
         }
+        return true;
+    });
+}
+
+bool GameState::SweepBallHero(int i, float* out_t) const {
+    // Sweep in the hero's frame: the hero's rect holds still at its previous
+    // position and the ball moves by its own motion minus the hero's. A ball
+    // that bounced this tick travels two legs meeting at the ground.
+    const SDL_FRect hero_prev = HeroPrevRect();
+    const SDL_FPoint hero_delta{hero_.pos.x - hero_.prev_pos.x, hero_.pos.y - hero_.prev_pos.y};
+    const float bounce_t = balls_.bounce_t[i];
+    const float leg_t[3] = {0.0f, bounce_t < 1.0f ? bounce_t : 1.0f, 1.0f};
+    const int points = bounce_t < 1.0f ? 3 : 2;
+    for (int leg = 0; leg + 1 < points; ++leg) {
+        const float t0 = leg_t[leg];
+        const float t1 = leg_t[leg + 1];
+        const SDL_FPoint from = BallPositionAt(i, t0);
+        const SDL_FPoint to = BallPositionAt(i, t1);
+        const SDL_FPoint start{from.x - hero_delta.x * t0, from.y - hero_delta.y * t0};
+        const SDL_FPoint delta{to.x - hero_delta.x * t1 - start.x, to.y - hero_delta.y * t1 - start.y};
+        float t = 0.0f;
+        if (SweepCircleRect(start, delta, balls_.radius[i], hero_prev, &t)) {
+            *out_t = t0 + (t1 - t0) * t;
+            return true;
+        }
+    }
+    return false;
+}
+
+SDL_FPoint GameState::BallPositionAt(int i, float t) const {
+    const float x = Lerp(balls_.prev_x[i], balls_.pos_x[i], t);
+    const float bounce_t = balls_.bounce_t[i];
+    if (bounce_t >= 1.0f) {
+        return SDL_FPoint{x, Lerp(balls_.prev_y[i], balls_.pos_y[i], t)};
+    }
+    const float contact_y = LandRect().y + kGroundOffset - balls_.radius[i];
+    if (t <= bounce_t) {
+        return SDL_FPoint{x, bounce_t > 0.0f ? Lerp(balls_.prev_y[i], contact_y, t / bounce_t) : contact_y};
     }
-    for (auto& number : numbers_) {
-        if (!number.alive) {
-            continue;
+    return SDL_FPoint{x, Lerp(contact_y, balls_.pos_y[i], (t - bounce_t) / (1.0f - bounce_t))};
+}
+
+void GameState::RemoveBall(int i) {
+    collision_grid_.Remove(static_cast<int>(balls_.index.HandleAt(i).slot));
+    balls_.Remove(i);
+}
+
+void GameState::RemoveNumber(int i) {
+    collision_grid_.Remove(BallPool::kCapacity + static_cast<int>(numbers_.index.HandleAt(i).slot));
+    numbers_.Remove(i);
+}
+
+void GameState::SyncCollisionGrid() {
+    for (int i = 0; i < balls_.Size(); ++i) {
+        const float radius = balls_.radius[i];
+        SDL_FRect box = UnionRect(
+            SDL_FRect{balls_.prev_x[i] - radius, balls_.prev_y[i] - radius, radius * 2.0f, radius * 2.0f},
+            SDL_FRect{balls_.pos_x[i] - radius, balls_.pos_y[i] - radius, radius * 2.0f, radius * 2.0f});
+        if (balls_.bounce_t[i] < 1.0f) {
+            // The path dipped to the ground between the two samples.
+            box.h = LandRect().y + kGroundOffset - box.y;
         }
-        SDL_FRect number_rect{number.pos.x - 20.0f, number.pos.y - 20.0f, 40.0f, 40.0f};
-        if (RectOverlap(hero_rect, number_rect)) {
-            number.collecting = true;
+        collision_grid_.Update(static_cast<int>(balls_.index.HandleAt(i).slot), box, kCollideBall);
+    }
+    for (int i = 0; i < numbers_.Size(); ++i) {
+        const SDL_FRect box =
+            UnionRect(SDL_FRect{numbers_.prev_x[i] - 20.0f, numbers_.prev_y[i] - 20.0f, 40.0f, 40.0f},
+                      SDL_FRect{numbers_.pos_x[i] - 20.0f, numbers_.pos_y[i] - 20.0f, 40.0f, 40.0f});
+        collision_grid_.Update(BallPool::kCapacity + static_cast<int>(numbers_.index.HandleAt(i).slot), box,
+                               kCollideNumber);
+    }
+}
+
+void GameState::UpdateSpawners(Game& game, float delta_seconds) {
+    PROFILE_SCOPE(ProfileZone::kSpawners);
+    const int spawn_count = game.Config().spawn_multiplier;
+    ball_timer_ += delta_seconds;
+    if (ball_timer_ >= 1.0f) {
+        ball_timer_ = 0.0f;
+        for (int i = 0; i < spawn_count; ++i) {
+            SpawnBall(game);
+        }
+    }
+
+    number_timer_ += delta_seconds;
+    if (number_timer_ >= 5.0f) {
+        number_timer_ = 0.0f;
+        for (int i = 0; i < spawn_count; ++i) {
+            SpawnNumber(game);
         }
     }
 }
@@ -533,7 +741,7 @@ void GameState::OnDeath(Game& game) {
     dead_ = true;
 
     StartEffects();
-    game.GetAssets().PlaySound("die00", MIX_MAX_VOLUME);
+    game.GetAssets().PlaySound(SoundId::kDie00, MIX_MAX_VOLUME);
 }
 
 void GameState::StartEffects() {
@@ -542,65 +750,52 @@ void GameState::StartEffects() {
     red_border_timer_ = 1.0f;
     shake_timer_ = 0.6f;
 
-    blood_particles_.clear();
-    for (int i = 0; i < 50; ++i) {
-        Particle particle;
-        particle.pos = SDL_FPoint{hero_.pos.x, hero_.pos.y - 45.0f};
-        particle.velocity = SDL_FPoint{RandomRange(-300.0f, 300.0f), RandomRange(-1000.0f, 0.0f)};
-        particle.life = RandomRange(0.8f, 1.5f);
-        particle.scale = RandomRange(0.2f, 1.5f);
-        particle.color = SDL_Color{255, 255, 255, 255};
-        blood_particles_.push_back(particle);
-    }
-
-    dead_parts_.clear();
-    for (int i = 0; i < 8; ++i) {
-        Particle part;
-        part.pos = SDL_FPoint{hero_.pos.x, hero_.pos.y - 45.0f};
-        part.velocity = SDL_FPoint{RandomRange(-800.0f, 800.0f), RandomRange(-1000.0f, 0.0f)};
-        part.life = RandomRange(1.0f, 2.0f);
-        part.scale = 1.0f;
-        part.texture_index = RandomInt(0, 7);
-        dead_parts_.push_back(part);
-    }
+    particles_.Clear();
+    particles_.Emit(EmitterId::kBlood, hero_.pos.x, hero_.pos.y - 45.0f, particle_density_);
+    particles_.Emit(EmitterId::kDeadParts, hero_.pos.x, hero_.pos.y - 45.0f, particle_density_);
 }
 
 void GameState::SpawnBall(Game& game) {
-    Ball ball;
-    ball.texture_index = RandomInt(0, 4);
+    const int i = balls_.Add();
+    if (i < 0) {
+        return;
+    }
+    const int texture_index = RandomInt(0, 4);
+    balls_.texture_index[i] = static_cast<std::uint8_t>(texture_index);
     const float scale = RandomRange(1.2f, 1.5f);
-    ball.scale = scale;
+    balls_.scale[i] = scale;
     if (left_ball_) {
-        ball.pos.x = -70.0f;
-        ball.velocity.x = RandomRange(150.0f, 200.0f);
+        balls_.pos_x[i] = -70.0f;
+        balls_.vel_x[i] = RandomRange(150.0f, 200.0f);
     } else {
-        ball.pos.x = 1216.0f + 70.0f;
-        ball.velocity.x = -RandomRange(150.0f, 200.0f);
+        balls_.pos_x[i] = 1216.0f + 70.0f;
+        balls_.vel_x[i] = -RandomRange(150.0f, 200.0f);
     }
     left_ball_ = !left_ball_;
-    ball.pos.y = RandomRange(-50.0f, 150.0f);
-    ball.velocity.y = 0.0f;
+    balls_.pos_y[i] = RandomRange(-50.0f, 150.0f);
+    balls_.prev_x[i] = balls_.pos_x[i];
+    balls_.prev_y[i] = balls_.pos_y[i];
 
-    const TextureAsset asset = game.GetAssets().GetTexture("ball" + std::to_string(ball.texture_index));
-    ball.radius = (static_cast<float>(asset.width) * scale) * 0.5f;
-    ball.alive = true;
-    balls_.push_back(ball);
+    const TextureAsset& asset = game.GetAssets().GetTexture(TextureFrame(TextureId::kBall0, texture_index));
+    balls_.radius[i] = (static_cast<float>(asset.width) * scale) * 0.5f;
 
-    game.GetAssets().PlaySound("toss", MIX_MAX_VOLUME / 3);
+    game.GetAssets().PlaySound(SoundId::kToss, MIX_MAX_VOLUME / 3);
 }
 
 void GameState::SpawnNumber(Game& game) {
     (void)game;
-    NumberItem number;
-    number.value = RandomInt(1, 4);
-    number.pos = SDL_FPoint{RandomRange(0.0f, 1216.0f), -20.0f};
-    number.velocity = SDL_FPoint{0.0f, 0.0f};
-    number.angle = RandomRange(0.0f, 360.0f);
-    number.alive = true;
-    number.collecting = false;
-    number.flash_timer = 0.2f;
-    number.tint = SDL_Color{255, 255, 255, 255};
-    numbers_.push_back(number);
+    const int i = numbers_.Add();
+    if (i < 0) {
+        return;
+    }
+    numbers_.value[i] = static_cast<std::uint8_t>(RandomInt(1, 4));
+    numbers_.pos_x[i] = RandomRange(0.0f, 1216.0f);
+    numbers_.pos_y[i] = -20.0f;
+    numbers_.prev_x[i] = numbers_.pos_x[i];
+    numbers_.prev_y[i] = numbers_.pos_y[i];
+    numbers_.angle[i] = RandomRange(0.0f, 360.0f);
+    numbers_.flash_timer[i] = 0.2f;
+    numbers_.tint[i] = SDL_Color{255, 255, 255, 255};
 }
 
 void GameState::UpdateGauge() {
@@ -619,6 +814,10 @@ SDL_FRect GameState::HeroRect() const {
     return SDL_FRect{hero_.pos.x - 40.0f, hero_.pos.y - 80.0f, hero_.body.w, hero_.body.h};
 }
 
+SDL_FRect GameState::HeroPrevRect() const {
+    return SDL_FRect{hero_.prev_pos.x - 40.0f, hero_.prev_pos.y - 80.0f, hero_.body.w, hero_.body.h};
+}
+
 void GameState::StartResultOverlay(Game& game) {
     if (result_overlay_active_) {
         return;
@@ -630,18 +829,20 @@ void GameState::StartResultOverlay(Game& game) {
 
     if (!result_best_updated_ && gauge_count_ > best_score_) {
         best_score_ = gauge_count_;
-        storage_.SaveBestScore(best_score_);
+        if (!game.Replay().Playing()) {
+            storage_.SaveBestScore(best_score_);
+        }
         result_best_updated_ = true;
     }
 
     const Assets& assets = game.GetAssets();
-    const TextureAsset gamecenter = assets.GetTexture("buttonGamecenter0");
-    const TextureAsset share = assets.GetTexture("buttonShare0");
-    const TextureAsset play = assets.GetTexture("buttonPlay0");
+    const TextureAsset gamecenter = assets.GetTexture(TextureId::kButtonGamecenter0);
+    const TextureAsset share = assets.GetTexture(TextureId::kButtonShare0);
+    const TextureAsset play = assets.GetTexture(TextureId::kButtonPlay0);
 
-    result_gamecenter_ = {120.0f, 800.0f + 304.0f, static_cast<float>(gamecenter.width), static_cast<float>(gamecenter.height), false, "buttonGamecenter"};
-    result_share_ = {1216.0f - 120.0f, 800.0f + 304.0f, static_cast<float>(share.width), static_cast<float>(share.height), false, "buttonShare"};
-    result_play_ = {1216.0f / 2.0f, 800.0f + 284.0f, static_cast<float>(play.width), static_cast<float>(play.height), false, "buttonPlay"};
+    result_gamecenter_ = {120.0f, 800.0f + 304.0f, static_cast<float>(gamecenter.width), static_cast<float>(gamecenter.height), false, TextureId::kButtonGamecenter0};
+    result_share_ = {1216.0f - 120.0f, 800.0f + 304.0f, static_cast<float>(share.width), static_cast<float>(share.height), false, TextureId::kButtonShare0};
+    result_play_ = {1216.0f / 2.0f, 800.0f + 284.0f, static_cast<float>(play.width), static_cast<float>(play.height), false, TextureId::kButtonPlay0};
 }
 
 bool GameState::IsInsideButton(const Button& button, float x, float y) const {
@@ -674,25 +875,24 @@ void GameState::UpdateResultOverlay(float delta_seconds) {
 }
 
 void GameState::RenderResultOverlay(Game& game, const RenderContext& ctx) {
-    SDL_Renderer* renderer = game.Renderer();
+    RenderQueue& queue = game.Queue();
     Assets& assets = game.GetAssets();
 
-    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
-    SDL_SetRenderDrawColor(renderer, 255, 255, 255, 200);
-    SDL_FRect overlay = ctx.WorldToScreenRect(SDL_FRect{0.0f, 0.0f, 1216.0f, 800.0f});
-    SDL_RenderFillRectF(renderer, &overlay);
+    queue.SetLayer(RenderLayer::kOverlay);
+    queue.AddFill(ctx.WorldToScreenRect(SDL_FRect{0.0f, 0.0f, 1216.0f, 800.0f}), SDL_Color{255, 255, 255, 200});
 
-    const BitmapFont* score_font = assets.GetFont("numberScoreEnd");
+    const BitmapFont* score_font = assets.GetFont(FontId::kNumberScoreEnd);
     if (score_font) {
         const float group_y = 800.0f / 2.0f - 200.0f;
-        const TextureAsset word_best = assets.GetTexture("wordBest");
-        const TextureAsset word_your = assets.GetTexture("wordYour");
-        const TextureAsset dot = assets.GetTexture("dot");
+        const TextureAsset word_best = assets.GetTexture(TextureId::kWordBest);
+        const TextureAsset word_your = assets.GetTexture(TextureId::kWordYour);
+        const TextureAsset dot = assets.GetTexture(TextureId::kDot);
 
         const auto score_width = [&](int score) {
-            const int integer_digits = static_cast<int>(std::to_string(score / 10).size());
-            const int decimal_digits = 2;
-            return static_cast<float>(integer_digits * 55 + 2 + dot.width + decimal_digits * 55);
+            char integer_text[12];
+            std::snprintf(integer_text, sizeof(integer_text), "%d", score / 10);
+            return score_font->MeasureText(integer_text, 1.0f) + 2.0f + static_cast<float>(dot.width) +
+                   score_font->MeasureText("00", 1.0f);
         };
 
         const float best_score_width = score_width(best_score_);
@@ -701,31 +901,33 @@ void GameState::RenderResultOverlay(Game& game, const RenderContext& ctx) {
         const float your_group_x = 1216.0f / 2.0f + 150.0f;
         const float score_y = group_y + static_cast<float>(word_best.height) + 30.0f;
 
-        DrawTexture(renderer, ctx, word_best, best_group_x + (best_score_width - static_cast<float>(word_best.width)) * 0.5f,
+        DrawTexture(queue, ctx, word_best, best_group_x + (best_score_width - static_cast<float>(word_best.width)) * 0.5f,
                     group_y, 1.0f, 1.0f, SDL_Color{0, 0, 0, 255});
-        DrawTexture(renderer, ctx, word_your, your_group_x + (your_score_width - static_cast<float>(word_your.width)) * 0.5f,
+        DrawTexture(queue, ctx, word_your, your_group_x + (your_score_width - static_cast<float>(word_your.width)) * 0.5f,
                     group_y, 1.0f, 1.0f, SDL_Color{42, 216, 216, 255});
 
+        TextBatch text(queue, score_font);
         const auto draw_score = [&](float x, float y, int score, SDL_Color color) {
             const int integer = score / 10;
             const int decimal_two = (score % 10) * 10;
+            char integer_text[12];
+            std::snprintf(integer_text, sizeof(integer_text), "%d", integer);
             char decimal_text[3];
             std::snprintf(decimal_text, sizeof(decimal_text), "%02d", decimal_two);
             int integer_width = 0;
-            score_font->Draw(renderer, ctx, std::to_string(integer), x, y, 1.0f, color, &integer_width);
-            DrawTexture(renderer, ctx, dot, x + static_cast<float>(integer_width) + 2.0f, y + 20.0f, 1.0f, 1.0f, color);
-            score_font->Draw(renderer, ctx, decimal_text, x + static_cast<float>(integer_width) + 2.0f + static_cast<float>(dot.width),
-                             y, 1.0f, color);
+            text.Add(ctx, integer_text, x, y, 1.0f, color, &integer_width);
+            DrawTexture(queue, ctx, dot, x + static_cast<float>(integer_width) + 2.0f, y + 20.0f, 1.0f, 1.0f, color);
+            text.Add(ctx, decimal_text, x + static_cast<float>(integer_width) + 2.0f + static_cast<float>(dot.width), y, 1.0f, color);
         };
 
         draw_score(best_group_x, score_y, best_score_, SDL_Color{0, 0, 0, 255});
         draw_score(your_group_x, score_y, gauge_count_, your_flash_color_);
     }
 
-    DrawTextureCentered(renderer, ctx, assets.GetTexture(result_gamecenter_.key_base + std::string(result_gamecenter_.pressed ? "1" : "0")),
+    DrawTextureCentered(queue, ctx, assets.GetTexture(TextureFrame(result_gamecenter_.texture, result_gamecenter_.pressed ? 1 : 0)),
                         result_gamecenter_.x, result_gamecenter_.y, 1.0f, 1.0f, SDL_Color{255, 255, 255, 255});
-    DrawTextureCentered(renderer, ctx, assets.GetTexture(result_share_.key_base + std::string(result_share_.pressed ? "1" : "0")),
+    DrawTextureCentered(queue, ctx, assets.GetTexture(TextureFrame(result_share_.texture, result_share_.pressed ? 1 : 0)),
                         result_share_.x, result_share_.y, 1.0f, 1.0f, SDL_Color{255, 255, 255, 255});
-    DrawTextureCentered(renderer, ctx, assets.GetTexture(result_play_.key_base + std::string(result_play_.pressed ? "1" : "0")),
+    DrawTextureCentered(queue, ctx, assets.GetTexture(TextureFrame(result_play_.texture, result_play_.pressed ? 1 : 0)),
                         result_play_.x, result_play_.y, 1.0f, 1.0f, SDL_Color{255, 255, 255, 255});
 }
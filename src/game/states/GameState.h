@@ -1,12 +1,20 @@
 #pragma once
 
 #include <SDL2/SDL.h>
+#include <cstdint>
 #include <string>
 #include <vector>
 
+#include "game/AssetIds.h"
+#include "game/Broadphase.h"
+#include "game/EntityPool.h"
+#include "game/ParticleSystem.h"
+#include "game/RenderQueue.h"
 #include "game/ScoreStorage.h"
 #include "game/State.h"
-#include "game/StickmanSkeleton.h"
+#include "game/SkeletonInstance.h"
+
+class Assets;
 
 class GameState : public State {
 public:
@@ -18,42 +26,71 @@ public:
     void Update(Game& game, float delta_seconds) override;
     void Render(Game& game) override;
 
+    bool IsDead() const { return dead_; }
+    int BallCount() const { return balls_.Size(); }
+    int NumberCount() const { return numbers_.Size(); }
+
 private:
+    // Every moving entity keeps the position from the previous tick so Render
+    // can interpolate between fixed simulation steps.
     struct Hero {
         SDL_FPoint pos{0.0f, 0.0f};
+        SDL_FPoint prev_pos{0.0f, 0.0f};
         SDL_FPoint velocity{0.0f, 0.0f};
         float dir = 0.0f;
         bool alive = true;
         SDL_FRect body{0.0f, 0.0f, 80.0f, 80.0f};
     };
 
-    struct Ball {
-        SDL_FPoint pos{0.0f, 0.0f};
-        SDL_FPoint velocity{0.0f, 0.0f};
-        float scale = 1.0f;
-        float radius = 40.0f;
-        int texture_index = 0;
-        bool alive = true;
-    };
-
-    struct NumberItem {
-        SDL_FPoint pos{0.0f, 0.0f};
-        SDL_FPoint velocity{0.0f, 0.0f};
-        float angle = 0.0f;
-        int value = 1;
-        bool alive = true;
-        bool collecting = false;
-        float flash_timer = 0.0f;
-        SDL_Color tint{255, 255, 255, 255};
+    // Balls and number items live in fixed-capacity structure-of-arrays pools
+    // (see PoolIndex): each field is its own contiguous array indexed
+    // [0, Size()), so the per-tick passes stream only the fields they use.
+    // Removal swaps the last entity into the hole, so loops that remove walk
+    // backwards. Spawns past capacity are dropped.
+    struct BallPool {
+        static constexpr int kCapacity = 4096;
+
+        PoolIndex index{kCapacity};
+        std::vector<float> pos_x = std::vector<float>(kCapacity);
+        std::vector<float> pos_y = std::vector<float>(kCapacity);
+        std::vector<float> prev_x = std::vector<float>(kCapacity);
+        std::vector<float> prev_y = std::vector<float>(kCapacity);
+        std::vector<float> vel_x = std::vector<float>(kCapacity);
+        std::vector<float> vel_y = std::vector<float>(kCapacity);
+        std::vector<float> radius = std::vector<float>(kCapacity);
+        std::vector<float> scale = std::vector<float>(kCapacity);
+        // Fraction of the last tick at which the ball bounced off the ground,
+        // 1 when it didn't; the swept hero test bends the path there.
+        std::vector<float> bounce_t = std::vector<float>(kCapacity);
+        std::vector<std::uint8_t> texture_index = std::vector<std::uint8_t>(kCapacity);
+
+        int Size() const { return index.Size(); }
+        // Dense index of the new ball with every field zeroed, or -1 when full.
+        int Add();
+        void Remove(int i);
+        void Clear() { index.Clear(); }
     };
 
-    struct Particle {
-        SDL_FPoint pos{0.0f, 0.0f};
-        SDL_FPoint velocity{0.0f, 0.0f};
-        float life = 0.0f;
-        float scale = 1.0f;
-        int texture_index = 0;
-        SDL_Color color{255, 255, 255, 255};
+    struct NumberPool {
+        static constexpr int kCapacity = 4096;
+
+        PoolIndex index{kCapacity};
+        std::vector<float> pos_x = std::vector<float>(kCapacity);
+        std::vector<float> pos_y = std::vector<float>(kCapacity);
+        std::vector<float> prev_x = std::vector<float>(kCapacity);
+        std::vector<float> prev_y = std::vector<float>(kCapacity);
+        std::vector<float> vel_x = std::vector<float>(kCapacity);
+        std::vector<float> vel_y = std::vector<float>(kCapacity);
+        std::vector<float> flash_timer = std::vector<float>(kCapacity);
+        std::vector<float> angle = std::vector<float>(kCapacity);
+        std::vector<SDL_Color> tint = std::vector<SDL_Color>(kCapacity);
+        std::vector<std::uint8_t> value = std::vector<std::uint8_t>(kCapacity);
+        std::vector<std::uint8_t> collecting = std::vector<std::uint8_t>(kCapacity);
+
+        int Size() const { return index.Size(); }
+        int Add();
+        void Remove(int i);
+        void Clear() { index.Clear(); }
     };
 
     struct Button {
@@ -62,7 +99,7 @@ private:
         float w = 0.0f;
         float h = 0.0f;
         bool pressed = false;
-        std::string key_base;
+        TextureId texture = TextureId::kEmpty;
     };
 
     int best_score_ = 0;
@@ -70,10 +107,14 @@ private:
     bool left_ball_ = true;
 
     Hero hero_{};
-    std::vector<Ball> balls_;
-    std::vector<NumberItem> numbers_;
-    std::vector<Particle> blood_particles_;
-    std::vector<Particle> dead_parts_;
+    BallPool balls_;
+    NumberPool numbers_;
+    // Balls and numbers, boxed over their path through the last tick, for
+    // the hero's swept queries. Grid ids are pool slots, numbers offset by
+    // BallPool::kCapacity.
+    UniformGrid collision_grid_;
+    ParticleSystem particles_;
+    int particle_density_ = 1;  // GameConfig::particle_density
 
     float elapsed_ = 0.0f;
     float ball_timer_ = 0.0f;
@@ -101,7 +142,8 @@ private:
     float effect_blood_timer_ = 0.0f;
     float red_border_timer_ = 0.0f;
     float shake_timer_ = 0.0f;
-    StickmanSkeleton stickman_;
+    SDL_FPoint shake_offset_{0.0f, 0.0f};
+    SkeletonInstance stickman_;
     bool stickman_loaded_ = false;
     bool was_moving_ = false;
     std::string hero_animation_;
@@ -117,6 +159,7 @@ private:
     ScoreStorage storage_{"save.dat"};
 
     void ResetHero();
+    void StorePreviousPositions();
     void SpawnBall(Game& game);
     void SpawnNumber(Game& game);
     void UpdateGauge();
@@ -125,15 +168,32 @@ private:
     void UpdateBalls(float delta_seconds);
     void UpdateNumbers(Game& game, float delta_seconds);
     void UpdateParticles(float delta_seconds);
+    void UpdateSpawners(Game& game, float delta_seconds);
 
+    void RemoveBall(int i);
+    void RemoveNumber(int i);
+    void SyncCollisionGrid();
     void CheckCollisions(Game& game);
+    // Where ball `i` was at fraction `t` of the last tick, following its
+    // bounce; SweepBallHero gives the tick fraction of first contact.
+    SDL_FPoint BallPositionAt(int i, float t) const;
+    bool SweepBallHero(int i, float* out_t) const;
     void OnDeath(Game& game);
     void StartEffects();
     void StartResultOverlay(Game& game);
     bool IsInsideButton(const Button& button, float x, float y) const;
     void UpdateResultOverlay(float delta_seconds);
+    // Render layers, each its own profiler zone.
+    // `shake` is the screen-pixel offset already applied to the other layers.
+    void RenderBackground(Game& game, SDL_Point shake) const;
+    void RenderBalls(RenderQueue& queue, const RenderContext& ctx, const Assets& assets, float alpha) const;
+    void RenderNumbers(RenderQueue& queue, const RenderContext& ctx, const Assets& assets, float alpha) const;
+    void RenderHero(RenderQueue& queue, const RenderContext& ctx, const Assets& assets, float alpha) const;
+    void RenderParticles(RenderQueue& queue, const RenderContext& ctx, const Assets& assets, float alpha) const;
+    void RenderHud(RenderQueue& queue, const RenderContext& ctx, const Assets& assets) const;
     void RenderResultOverlay(Game& game, const RenderContext& ctx);
 
     SDL_FRect LandRect() const;
     SDL_FRect HeroRect() const;
+    SDL_FRect HeroPrevRect() const;
 };
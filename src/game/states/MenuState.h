@@ -3,9 +3,10 @@
 #include <SDL2/SDL.h>
 #include <string>
 
+#include "game/AssetIds.h"
 #include "game/ScoreStorage.h"
 #include "game/State.h"
-#include "game/StickmanSkeleton.h"
+#include "game/SkeletonInstance.h"
 
 class MenuState : public State {
 public:
@@ -24,7 +25,7 @@ private:
         float w = 0.0f;
         float h = 0.0f;
         bool pressed = false;
-        std::string key_base;
+        TextureId texture = TextureId::kEmpty;
     };
 
     float elapsed_ = 0.0f;
@@ -37,7 +38,7 @@ private:
     int land_index_ = 0;
     float score_color_timer_ = 0.0f;
     SDL_Color score_color_{0, 0, 0, 255};
-    StickmanSkeleton stickman_{};
+    SkeletonInstance stickman_{};
     bool stickman_loaded_ = false;
 
     Button gamecenter_{};
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "game/AssetLoader.h"
 #include "game/State.h"
 
 class PreloadState : public State {
@@ -10,4 +11,6 @@ public:
     void Update(Game& game, float delta_seconds) override;
     void Render(Game& game) override;
 
+private:
+    AssetLoader loader_;
 };
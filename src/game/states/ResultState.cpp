@@ -1,7 +1,6 @@
 #include "ResultState.h"
 
 #include <cstdio>
-#include <random>
 #include <string>
 
 #include <SDL2/SDL.h>
@@ -10,17 +9,10 @@
 #include "game/Assets.h"
 #include "game/Game.h"
 #include "game/MathUtils.h"
+#include "game/Random.h"
 #include "game/RenderHelpers.h"
 #include "game/states/MenuState.h"
 
-namespace {
-int RandomInt(int min_value, int max_value) {
-    static std::mt19937 rng{static_cast<unsigned int>(SDL_GetTicks())};
-    std::uniform_int_distribution<int> dist(min_value, max_value);
-    return dist(rng);
-}
-}
-
 ResultState::ResultState(int best_score, int your_score, int land_index)
     : best_score_(best_score), your_score_(your_score), land_index_(land_index), storage_("save.dat") {}
 
@@ -33,18 +25,19 @@ void ResultState::Enter(Game& game) {
         storage_.SaveBestScore(best_score_);
     }
 
+    game.GetAssets().Prefetch(TextureSet::kGameplay);
     const Assets& assets = game.GetAssets();
-    const TextureAsset gamecenter = assets.GetTexture("buttonGamecenter0");
-    const TextureAsset share = assets.GetTexture("buttonShare0");
-    const TextureAsset play = assets.GetTexture("buttonPlay0");
+    const TextureAsset gamecenter = assets.GetTexture(TextureId::kButtonGamecenter0);
+    const TextureAsset share = assets.GetTexture(TextureId::kButtonShare0);
+    const TextureAsset play = assets.GetTexture(TextureId::kButtonPlay0);
 
-    gamecenter_ = {120.0f, 800.0f + 304.0f, static_cast<float>(gamecenter.width), static_cast<float>(gamecenter.height), false, "buttonGamecenter"};
-    share_ = {1216.0f - 120.0f, 800.0f + 304.0f, static_cast<float>(share.width), static_cast<float>(share.height), false, "buttonShare"};
-    play_ = {1216.0f / 2.0f, 800.0f + 284.0f, static_cast<float>(play.width), static_cast<float>(play.height), false, "buttonPlay"};
+    gamecenter_ = {120.0f, 800.0f + 304.0f, static_cast<float>(gamecenter.width), static_cast<float>(gamecenter.height), false, TextureId::kButtonGamecenter0};
+    share_ = {1216.0f - 120.0f, 800.0f + 304.0f, static_cast<float>(share.width), static_cast<float>(share.height), false, TextureId::kButtonShare0};
+    play_ = {1216.0f / 2.0f, 800.0f + 284.0f, static_cast<float>(play.width), static_cast<float>(play.height), false, TextureId::kButtonPlay0};
 }
 
 void ResultState::Exit(Game& game) {
-    (void)game;
+    game.GetAssets().Release(TextureSet::kGameplay);
 }
 
 bool ResultState::IsInside(const Button& button, float x, float y) const {
@@ -57,17 +50,17 @@ void ResultState::HandleEvent(Game& game, const SDL_Event& event) {
         const SDL_FPoint pos = game.RenderCtx().ScreenToWorld(event.button.x, event.button.y);
         if (IsInside(gamecenter_, pos.x, pos.y)) {
             gamecenter_.pressed = true;
-            game.GetAssets().PlaySound("uiButton", MIX_MAX_VOLUME / 2);
+            game.GetAssets().PlaySound(SoundId::kUiButton, MIX_MAX_VOLUME / 2);
             return;
         }
         if (IsInside(share_, pos.x, pos.y)) {
             share_.pressed = true;
-            game.GetAssets().PlaySound("uiButton", MIX_MAX_VOLUME / 2);
+            game.GetAssets().PlaySound(SoundId::kUiButton, MIX_MAX_VOLUME / 2);
             return;
         }
         if (IsInside(play_, pos.x, pos.y)) {
             play_.pressed = true;
-            game.GetAssets().PlaySound("uiButton", MIX_MAX_VOLUME / 2);
+            game.GetAssets().PlaySound(SoundId::kUiButton, MIX_MAX_VOLUME / 2);
             return;
         }
     }
@@ -106,33 +99,31 @@ void ResultState::Update(Game& game, float delta_seconds) {
 
 void ResultState::Render(Game& game) {
     SDL_Renderer* renderer = game.Renderer();
+    RenderQueue& queue = game.Queue();
     const RenderContext& ctx = game.RenderCtx();
     Assets& assets = game.GetAssets();
 
     SDL_SetRenderDrawColor(renderer, 255, 255, 255, 255);
     SDL_RenderClear(renderer);
 
-    DrawTexture(renderer, ctx, assets.GetTexture("bg"), 0.0f, 0.0f, 1.0f, 1.0f, SDL_Color{255, 255, 255, 255});
-    DrawTexture(renderer, ctx, assets.GetTexture("land" + std::to_string(land_index_)), 0.0f, 800.0f - 204.0f, 1.0f, 1.0f,
-                SDL_Color{255, 255, 255, 255});
+    game.Background().Draw(renderer, ctx, assets, TextureFrame(TextureId::kLand0, land_index_),
+                           SDL_Color{255, 255, 255, 255});
 
-    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
-    SDL_SetRenderDrawColor(renderer, 255, 255, 255, 200);
-    SDL_FRect overlay = ctx.WorldToScreenRect(SDL_FRect{0.0f, 0.0f, 1216.0f, 800.0f});
-    SDL_RenderFillRectF(renderer, &overlay);
+    queue.SetLayer(RenderLayer::kOverlay);
+    queue.AddFill(ctx.WorldToScreenRect(SDL_FRect{0.0f, 0.0f, 1216.0f, 800.0f}), SDL_Color{255, 255, 255, 200});
 
-    const BitmapFont* score_font = assets.GetFont("numberScoreEnd");
+    const BitmapFont* score_font = assets.GetFont(FontId::kNumberScoreEnd);
     if (score_font) {
         const float group_y = 800.0f / 2.0f - 200.0f;
-        const TextureAsset word_best = assets.GetTexture("wordBest");
-        const TextureAsset word_your = assets.GetTexture("wordYour");
-        const TextureAsset dot = assets.GetTexture("dot");
+        const TextureAsset word_best = assets.GetTexture(TextureId::kWordBest);
+        const TextureAsset word_your = assets.GetTexture(TextureId::kWordYour);
+        const TextureAsset dot = assets.GetTexture(TextureId::kDot);
 
         const auto score_width = [&](int score) {
-            const int integer_digits = static_cast<int>(std::to_string(score / 10).size());
-            const int decimal_digits = 2;
-            // NumberScoreEnd glyphs are fixed-width (55 advance in XML).
-            return static_cast<float>(integer_digits * 55 + 2 + dot.width + decimal_digits * 55);
+            char integer_text[12];
+            std::snprintf(integer_text, sizeof(integer_text), "%d", score / 10);
+            return score_font->MeasureText(integer_text, 1.0f) + 2.0f + static_cast<float>(dot.width) +
+                   score_font->MeasureText("00", 1.0f);
         };
 
         const float best_score_width = score_width(best_score_);
@@ -141,33 +132,33 @@ void ResultState::Render(Game& game) {
         const float your_group_x = 1216.0f / 2.0f + 150.0f;
         const float score_y = group_y + static_cast<float>(word_best.height) + 30.0f;
 
-        DrawTexture(renderer, ctx, word_best, best_group_x + (best_score_width - static_cast<float>(word_best.width)) * 0.5f,
+        DrawTexture(queue, ctx, word_best, best_group_x + (best_score_width - static_cast<float>(word_best.width)) * 0.5f,
                     group_y, 1.0f, 1.0f, SDL_Color{0, 0, 0, 255});
-        DrawTexture(renderer, ctx, word_your, your_group_x + (your_score_width - static_cast<float>(word_your.width)) * 0.5f,
+        DrawTexture(queue, ctx, word_your, your_group_x + (your_score_width - static_cast<float>(word_your.width)) * 0.5f,
                     group_y, 1.0f, 1.0f, SDL_Color{42, 216, 216, 255});
 
+        TextBatch text(queue, score_font);
         const auto draw_score = [&](float x, float y, int score, SDL_Color color) {
             const int integer = score / 10;
             const int decimal_two = (score % 10) * 10;
+            char integer_text[12];
+            std::snprintf(integer_text, sizeof(integer_text), "%d", integer);
             char decimal_text[3];
             std::snprintf(decimal_text, sizeof(decimal_text), "%02d", decimal_two);
             int integer_width = 0;
-            score_font->Draw(renderer, ctx, std::to_string(integer), x, y, 1.0f, color, &integer_width);
-            DrawTexture(renderer, ctx, dot, x + static_cast<float>(integer_width) + 2.0f, y + 20.0f, 1.0f, 1.0f, color);
-            score_font->Draw(renderer, ctx, decimal_text, x + static_cast<float>(integer_width) + 2.0f + static_cast<float>(dot.width),
-                             y, 1.0f, color);
+            text.Add(ctx, integer_text, x, y, 1.0f, color, &integer_width);
+            DrawTexture(queue, ctx, dot, x + static_cast<float>(integer_width) + 2.0f, y + 20.0f, 1.0f, 1.0f, color);
+            text.Add(ctx, decimal_text, x + static_cast<float>(integer_width) + 2.0f + static_cast<float>(dot.width), y, 1.0f, color);
         };
 
         draw_score(best_group_x, score_y, best_score_, SDL_Color{0, 0, 0, 255});
         draw_score(your_group_x, score_y, your_score_, your_flash_color_);
     }
 
-    DrawTextureCentered(renderer, ctx, assets.GetTexture(gamecenter_.key_base + std::string(gamecenter_.pressed ? "1" : "0")),
+    DrawTextureCentered(queue, ctx, assets.GetTexture(TextureFrame(gamecenter_.texture, gamecenter_.pressed ? 1 : 0)),
                         gamecenter_.x, gamecenter_.y, 1.0f, 1.0f, SDL_Color{255, 255, 255, 255});
-    DrawTextureCentered(renderer, ctx, assets.GetTexture(share_.key_base + std::string(share_.pressed ? "1" : "0")),
+    DrawTextureCentered(queue, ctx, assets.GetTexture(TextureFrame(share_.texture, share_.pressed ? 1 : 0)),
                         share_.x, share_.y, 1.0f, 1.0f, SDL_Color{255, 255, 255, 255});
-    DrawTextureCentered(renderer, ctx, assets.GetTexture(play_.key_base + std::string(play_.pressed ? "1" : "0")),
+    DrawTextureCentered(queue, ctx, assets.GetTexture(TextureFrame(play_.texture, play_.pressed ? 1 : 0)),
                         play_.x, play_.y, 1.0f, 1.0f, SDL_Color{255, 255, 255, 255});
-
-    SDL_RenderPresent(renderer);
 }
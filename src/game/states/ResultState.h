@@ -3,6 +3,7 @@
 #include <SDL2/SDL.h>
 #include <string>
 
+#include "game/AssetIds.h"
 #include "game/ScoreStorage.h"
 #include "game/State.h"
 
@@ -23,7 +24,7 @@ private:
         float w = 0.0f;
         float h = 0.0f;
         bool pressed = false;
-        std::string key_base;
+        TextureId texture = TextureId::kEmpty;
     };
 
     int best_score_ = 0;
@@ -1,11 +1,14 @@
 #include "game/Game.h"
+#include "game/GameConfig.h"
 
 int main(int argc, char* argv[]) {
-    (void)argc;
-    (void)argv;
+    GameConfig config;
+    if (!ParseGameConfig(argc, argv, &config)) {
+        return 1;
+    }
 
     Game game;
-    if (!game.Init()) {
+    if (!game.Init(config)) {
         return 1;
     }
 
@@ -0,0 +1,60 @@
+// Offline asset archive packer.
+//
+// Usage: archive_packer <out.pak> <file>...
+//
+// Packs the given files into one archive (see src/game/AssetArchive.h), each
+// stored under the path exactly as given, so run it from the repository root
+// with paths like "assets/Ball0.png". The game maps the archive and reads
+// every packed asset from it, falling back to the loose file otherwise.
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "game/AssetArchive.h"
+#include "game/MappedFile.h"
+
+int main(int argc, char* argv[]) {
+    if (argc < 3) {
+        std::fprintf(stderr, "usage: %s <out.pak> <file>...\n", argv[0]);
+        return 1;
+    }
+
+    std::vector<ArchiveFile> files;
+    std::size_t total_bytes = 0;
+    for (int i = 2; i < argc; ++i) {
+        MappedFile input;
+        if (!input.Open(argv[i])) {
+            std::fprintf(stderr, "cannot read %s\n", argv[i]);
+            return 1;
+        }
+        ArchiveFile file;
+        file.path = argv[i];
+        file.data.assign(input.Data(), input.Data() + input.Size());
+        total_bytes += file.data.size();
+        files.push_back(std::move(file));
+    }
+
+    std::vector<unsigned char> blob;
+    WriteArchive(files, &blob);
+
+    std::FILE* file = std::fopen(argv[1], "wb");
+    if (!file) {
+        std::fprintf(stderr, "cannot write %s\n", argv[1]);
+        return 1;
+    }
+    const bool written = std::fwrite(blob.data(), 1, blob.size(), file) == blob.size();
+    std::fclose(file);
+    if (!written) {
+        std::fprintf(stderr, "short write to %s\n", argv[1]);
+        return 1;
+    }
+
+    AssetArchive check;
+    if (!check.Open(argv[1]) || check.EntryCount() != static_cast<int>(files.size())) {
+        std::fprintf(stderr, "written archive failed validation\n");
+        return 1;
+    }
+    std::printf("%s: %zu files, %zu bytes (%zu of data)\n", argv[1], files.size(), blob.size(), total_bytes);
+    return 0;
+}
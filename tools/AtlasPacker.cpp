@@ -0,0 +1,296 @@
+// Offline texture atlas packer.
+//
+// Usage: atlas_packer <out_dir> <page_size> <png>... [-- <png>...]...
+//
+// Packs every input PNG into as few <page_size> x <page_size> pages as possible
+// (skyline bottom-left) and writes AtlasN.png plus an Atlas.txt index that
+// Assets::LoadAtlas reads at runtime. `--` starts a new group: a group's
+// sprites never share a page with another group's, so pages load and evict
+// with the texture set they belong to. Sprites are named after their file stem
+// ("assets/Ball0.png" -> "Ball0") and padded with extruded edge pixels so
+// scaled sampling never bleeds into a neighbour.
+
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_image.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace {
+constexpr int kPadding = 2;
+
+struct Sprite {
+    std::string name;
+    SDL_Surface* surface = nullptr;
+    int group = 0;
+    int page = -1;
+    SDL_Rect rect{0, 0, 0, 0};
+};
+
+struct SkylineNode {
+    int x = 0;
+    int y = 0;
+    int w = 0;
+};
+
+class SkylinePage {
+public:
+    explicit SkylinePage(int size) : size_(size) { nodes_.push_back(SkylineNode{0, 0, size}); }
+
+    bool Insert(int w, int h, SDL_Point* out_pos) {
+        int best_index = -1;
+        int best_y = size_;
+        int best_x = 0;
+        for (size_t i = 0; i < nodes_.size(); ++i) {
+            int y = 0;
+            if (!Fits(i, w, h, &y)) {
+                continue;
+            }
+            if (y < best_y || (y == best_y && nodes_[i].x < best_x)) {
+                best_index = static_cast<int>(i);
+                best_y = y;
+                best_x = nodes_[i].x;
+            }
+        }
+        if (best_index < 0) {
+            return false;
+        }
+        AddLevel(static_cast<size_t>(best_index), best_x, best_y, w, h);
+        *out_pos = SDL_Point{best_x, best_y};
+        return true;
+    }
+
+private:
+    int size_ = 0;
+    std::vector<SkylineNode> nodes_;
+
+    bool Fits(size_t index, int w, int h, int* out_y) const {
+        const int x = nodes_[index].x;
+        if (x + w > size_) {
+            return false;
+        }
+        int remaining = w;
+        int y = nodes_[index].y;
+        size_t i = index;
+        while (remaining > 0) {
+            if (i >= nodes_.size()) {
+                return false;
+            }
+            y = std::max(y, nodes_[i].y);
+            if (y + h > size_) {
+                return false;
+            }
+            remaining -= nodes_[i].w;
+            ++i;
+        }
+        *out_y = y;
+        return true;
+    }
+
+    void AddLevel(size_t index, int x, int y, int w, int h) {
+        nodes_.insert(nodes_.begin() + static_cast<std::ptrdiff_t>(index), SkylineNode{x, y + h, w});
+        for (size_t i = index + 1; i < nodes_.size(); ++i) {
+            const SkylineNode& prev = nodes_[i - 1];
+            SkylineNode& node = nodes_[i];
+            if (node.x >= prev.x + prev.w) {
+                break;
+            }
+            const int shrink = prev.x + prev.w - node.x;
+            node.x += shrink;
+            node.w -= shrink;
+            if (node.w > 0) {
+                break;
+            }
+            nodes_.erase(nodes_.begin() + static_cast<std::ptrdiff_t>(i));
+            --i;
+        }
+        for (size_t i = 0; i + 1 < nodes_.size(); ++i) {
+            if (nodes_[i].y == nodes_[i + 1].y) {
+                nodes_[i].w += nodes_[i + 1].w;
+                nodes_.erase(nodes_.begin() + static_cast<std::ptrdiff_t>(i + 1));
+                --i;
+            }
+        }
+    }
+};
+
+std::string FileStem(const std::string& path) {
+    const size_t slash = path.find_last_of("/\\");
+    const size_t start = (slash == std::string::npos) ? 0 : slash + 1;
+    const size_t dot = path.find_last_of('.');
+    const size_t end = (dot == std::string::npos || dot < start) ? path.size() : dot;
+    return path.substr(start, end - start);
+}
+
+void Blit(SDL_Surface* src, int sx, int sy, int w, int h, SDL_Surface* dst, int dx, int dy) {
+    SDL_Rect src_rect{sx, sy, w, h};
+    SDL_Rect dst_rect{dx, dy, w, h};
+    SDL_BlitSurface(src, &src_rect, dst, &dst_rect);
+}
+
+// Copies the sprite and repeats its border pixels kPadding times outward.
+void BlitExtruded(SDL_Surface* sprite, SDL_Surface* page, const SDL_Rect& rect) {
+    const int w = rect.w;
+    const int h = rect.h;
+    Blit(sprite, 0, 0, w, h, page, rect.x, rect.y);
+    for (int p = 1; p <= kPadding; ++p) {
+        Blit(sprite, 0, 0, 1, h, page, rect.x - p, rect.y);
+        Blit(sprite, w - 1, 0, 1, h, page, rect.x + w - 1 + p, rect.y);
+        Blit(sprite, 0, 0, w, 1, page, rect.x, rect.y - p);
+        Blit(sprite, 0, h - 1, w, 1, page, rect.x, rect.y + h - 1 + p);
+        for (int q = 1; q <= kPadding; ++q) {
+            Blit(sprite, 0, 0, 1, 1, page, rect.x - p, rect.y - q);
+            Blit(sprite, w - 1, 0, 1, 1, page, rect.x + w - 1 + p, rect.y - q);
+            Blit(sprite, 0, h - 1, 1, 1, page, rect.x - p, rect.y + h - 1 + q);
+            Blit(sprite, w - 1, h - 1, 1, 1, page, rect.x + w - 1 + p, rect.y + h - 1 + q);
+        }
+    }
+}
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    if (argc < 4) {
+        std::fprintf(stderr, "usage: %s <out_dir> <page_size> <png>...\n", argv[0]);
+        return 1;
+    }
+    const std::string out_dir = argv[1];
+    const int page_size = std::atoi(argv[2]);
+    if (page_size <= 0) {
+        std::fprintf(stderr, "invalid page size '%s'\n", argv[2]);
+        return 1;
+    }
+
+    if ((IMG_Init(IMG_INIT_PNG) & IMG_INIT_PNG) != IMG_INIT_PNG) {
+        std::fprintf(stderr, "IMG_Init failed: %s\n", SDL_GetError());
+        return 1;
+    }
+
+    std::vector<Sprite> sprites;
+    int group = 0;
+    for (int i = 3; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--") == 0) {
+            group++;
+            continue;
+        }
+        SDL_Surface* loaded = IMG_Load(argv[i]);
+        if (!loaded) {
+            std::fprintf(stderr, "failed to load %s: %s\n", argv[i], SDL_GetError());
+            return 1;
+        }
+        Sprite sprite;
+        sprite.name = FileStem(argv[i]);
+        sprite.group = group;
+        sprite.surface = SDL_ConvertSurfaceFormat(loaded, SDL_PIXELFORMAT_RGBA32, 0);
+        SDL_FreeSurface(loaded);
+        if (!sprite.surface) {
+            std::fprintf(stderr, "failed to convert %s: %s\n", argv[i], SDL_GetError());
+            return 1;
+        }
+        SDL_SetSurfaceBlendMode(sprite.surface, SDL_BLENDMODE_NONE);
+        sprites.push_back(sprite);
+    }
+
+    std::vector<Sprite*> order;
+    order.reserve(sprites.size());
+    for (auto& sprite : sprites) {
+        order.push_back(&sprite);
+    }
+    std::sort(order.begin(), order.end(), [](const Sprite* a, const Sprite* b) {
+        if (a->group != b->group) {
+            return a->group < b->group;
+        }
+        if (a->surface->h != b->surface->h) {
+            return a->surface->h > b->surface->h;
+        }
+        return a->surface->w > b->surface->w;
+    });
+
+    std::vector<SkylinePage> pages;
+    // Groups are sorted together; a new group only looks at its own pages.
+    size_t group_first_page = 0;
+    int current_group = 0;
+    for (Sprite* sprite : order) {
+        if (sprite->group != current_group) {
+            current_group = sprite->group;
+            group_first_page = pages.size();
+        }
+        const int padded_w = sprite->surface->w + kPadding * 2;
+        const int padded_h = sprite->surface->h + kPadding * 2;
+        if (padded_w > page_size || padded_h > page_size) {
+            std::fprintf(stderr, "%s (%dx%d) does not fit a %d page\n", sprite->name.c_str(), sprite->surface->w,
+                         sprite->surface->h, page_size);
+            return 1;
+        }
+        SDL_Point pos{0, 0};
+        size_t page_index = group_first_page;
+        for (; page_index < pages.size(); ++page_index) {
+            if (pages[page_index].Insert(padded_w, padded_h, &pos)) {
+                break;
+            }
+        }
+        if (page_index == pages.size()) {
+            pages.emplace_back(page_size);
+            pages.back().Insert(padded_w, padded_h, &pos);
+        }
+        sprite->page = static_cast<int>(page_index);
+        sprite->rect = SDL_Rect{pos.x + kPadding, pos.y + kPadding, sprite->surface->w, sprite->surface->h};
+    }
+
+    const std::string index_path = out_dir + "/Atlas.txt";
+    FILE* index = std::fopen(index_path.c_str(), "w");
+    if (!index) {
+        std::fprintf(stderr, "failed to open %s\n", index_path.c_str());
+        return 1;
+    }
+
+    // Pages are cropped to what is on them, so a small group's page does not
+    // cost a whole <page_size> square of texture memory.
+    std::vector<SDL_Point> extents(pages.size(), SDL_Point{0, 0});
+    for (const auto& sprite : sprites) {
+        SDL_Point& extent = extents[static_cast<size_t>(sprite.page)];
+        extent.x = std::max(extent.x, sprite.rect.x + sprite.rect.w + kPadding);
+        extent.y = std::max(extent.y, sprite.rect.y + sprite.rect.h + kPadding);
+    }
+
+    for (size_t page_index = 0; page_index < pages.size(); ++page_index) {
+        const SDL_Point extent = extents[page_index];
+        SDL_Surface* page = SDL_CreateRGBSurfaceWithFormat(0, extent.x, extent.y, 32, SDL_PIXELFORMAT_RGBA32);
+        if (!page) {
+            std::fprintf(stderr, "failed to allocate page: %s\n", SDL_GetError());
+            return 1;
+        }
+        for (const auto& sprite : sprites) {
+            if (sprite.page == static_cast<int>(page_index)) {
+                BlitExtruded(sprite.surface, page, sprite.rect);
+            }
+        }
+        const std::string page_name = "Atlas" + std::to_string(page_index) + ".png";
+        if (IMG_SavePNG(page, (out_dir + "/" + page_name).c_str()) != 0) {
+            std::fprintf(stderr, "failed to write %s: %s\n", page_name.c_str(), SDL_GetError());
+            SDL_FreeSurface(page);
+            return 1;
+        }
+        SDL_FreeSurface(page);
+        std::fprintf(index, "page %s\n", page_name.c_str());
+    }
+    for (const auto& sprite : sprites) {
+        std::fprintf(index, "sprite %s %d %d %d %d %d\n", sprite.name.c_str(), sprite.page, sprite.rect.x, sprite.rect.y,
+                     sprite.rect.w, sprite.rect.h);
+    }
+    std::fclose(index);
+
+    std::size_t page_bytes = 0;
+    for (const SDL_Point& extent : extents) {
+        page_bytes += static_cast<std::size_t>(extent.x) * static_cast<std::size_t>(extent.y) * 4;
+    }
+    std::printf("packed %zu sprites into %zu page(s), %zu KB\n", sprites.size(), pages.size(), page_bytes / 1024);
+    for (auto& sprite : sprites) {
+        SDL_FreeSurface(sprite.surface);
+    }
+    IMG_Quit();
+    return 0;
+}
@@ -0,0 +1,58 @@
+// Offline BMFont compiler.
+//
+// Usage: font_compiler <font.xml|font.fnt> <out.fnt>
+//
+// Rewrites a BMFont descriptor as a binary v3 .fnt (see
+// src/game/FontFormat.h). The game prefers the binary file and falls back to
+// the XML next to the glyph page when it is missing.
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "game/FontFormat.h"
+#include "game/MappedFile.h"
+
+int main(int argc, char* argv[]) {
+    if (argc != 3) {
+        std::fprintf(stderr, "usage: %s <font.xml|font.fnt> <out.fnt>\n", argv[0]);
+        return 1;
+    }
+
+    MappedFile input;
+    if (!input.Open(argv[1])) {
+        std::fprintf(stderr, "cannot read %s\n", argv[1]);
+        return 1;
+    }
+    FontDescriptor font;
+    std::string error;
+    if (!ParseFont(input.Data(), input.Size(), &font, &error)) {
+        std::fprintf(stderr, "failed to parse %s: %s\n", argv[1], error.c_str());
+        return 1;
+    }
+
+    std::vector<unsigned char> blob;
+    WriteFontBinary(font, &blob);
+    FontDescriptor check;
+    if (!ParseFont(blob.data(), blob.size(), &check, &error) || check.chars.size() != font.chars.size() ||
+        check.kernings.size() != font.kernings.size()) {
+        std::fprintf(stderr, "compiled font failed validation: %s\n", error.c_str());
+        return 1;
+    }
+
+    std::FILE* file = std::fopen(argv[2], "wb");
+    if (!file) {
+        std::fprintf(stderr, "cannot write %s\n", argv[2]);
+        return 1;
+    }
+    const bool written = std::fwrite(blob.data(), 1, blob.size(), file) == blob.size();
+    std::fclose(file);
+    if (!written) {
+        std::fprintf(stderr, "short write to %s\n", argv[2]);
+        return 1;
+    }
+
+    std::printf("%s: %zu bytes, %zu chars, %zu kerning pairs\n", argv[2], blob.size(), font.chars.size(),
+                font.kernings.size());
+    return 0;
+}
@@ -0,0 +1,51 @@
+// Offline skeleton compiler.
+//
+// Usage: skeleton_compiler <skeleton.json> <skeleton.atlas> <out.skel>
+//
+// Converts a Spine 2.1 JSON export plus its libGDX atlas into the flat binary
+// layout described in src/game/SkeletonFormat.h. StickmanSkeleton maps the
+// result and binds pointers into it, so the game never parses JSON at startup
+// or on state changes.
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "game/SkeletonFormat.h"
+
+int main(int argc, char* argv[]) {
+    if (argc != 4) {
+        std::fprintf(stderr, "usage: %s <skeleton.json> <skeleton.atlas> <out.skel>\n", argv[0]);
+        return 1;
+    }
+
+    std::vector<unsigned char> blob;
+    std::string error;
+    if (!CompileSkeleton(argv[1], argv[2], &blob, &error)) {
+        std::fprintf(stderr, "failed to compile %s: %s\n", argv[1], error.c_str());
+        return 1;
+    }
+    SkeletonView view;
+    if (!BindSkeleton(blob.data(), blob.size(), &view)) {
+        std::fprintf(stderr, "compiled skeleton failed validation\n");
+        return 1;
+    }
+
+    std::FILE* file = std::fopen(argv[3], "wb");
+    if (!file) {
+        std::fprintf(stderr, "cannot write %s\n", argv[3]);
+        return 1;
+    }
+    const bool written = std::fwrite(blob.data(), 1, blob.size(), file) == blob.size();
+    std::fclose(file);
+    if (!written) {
+        std::fprintf(stderr, "short write to %s\n", argv[3]);
+        return 1;
+    }
+
+    const SkeletonHeader& header = *view.header;
+    std::printf("%s: %u bytes, %u bones, %u slots, %u attachments, %u regions, %u animations, %u keys\n", argv[3],
+                header.size, header.bone_count, header.slot_count, header.attachment_count, header.region_count,
+                header.animation_count, header.key_count);
+    return 0;
+}
@@ -0,0 +1,109 @@
+// Offline sound bank compiler.
+//
+// Usage: sound_bank_compiler <out.bank>
+//
+// Decodes every sound listed in ASSET_SOUNDS through SDL_mixer, opened with
+// the same output spec as Game::Init, and writes the resulting PCM into one
+// bank (see src/game/SoundBankFormat.h). At runtime Assets::LoadSoundBank maps
+// the file and wraps each sound with Mix_QuickLoad_RAW, so startup does no OGG
+// decoding or resampling. Run from the repository root.
+
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_mixer.h>
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "game/AssetIds.h"
+#include "game/Constants.h"
+#include "game/SoundBankFormat.h"
+
+namespace {
+bool WriteFile(const char* path, const std::vector<unsigned char>& blob) {
+    std::FILE* file = std::fopen(path, "wb");
+    if (!file) {
+        return false;
+    }
+    const bool written = std::fwrite(blob.data(), 1, blob.size(), file) == blob.size();
+    return std::fclose(file) == 0 && written;
+}
+
+bool BuildBank(std::vector<unsigned char>* out_blob) {
+    // Mix_LoadWAV converts to whatever the device was opened with; insist on
+    // the exact spec the game asks for so the bank never needs converting.
+    int frequency = 0;
+    Uint16 format = 0;
+    int channels = 0;
+    Mix_QuerySpec(&frequency, &format, &channels);
+    if (frequency != constants::kAudioFrequency || format != MIX_DEFAULT_FORMAT ||
+        channels != constants::kAudioChannels) {
+        std::fprintf(stderr, "mixer opened at %d Hz, format 0x%x, %d channels instead of the game's spec\n", frequency,
+                     format, channels);
+        return false;
+    }
+
+    std::vector<SoundBankEntry> entries;
+    std::size_t total_bytes = 0;
+    for (int i = 0; i < kSoundCount; ++i) {
+        const char* path = SoundPath(static_cast<SoundId>(i));
+        Mix_Chunk* chunk = Mix_LoadWAV(path);
+        if (!chunk) {
+            std::fprintf(stderr, "cannot decode %s: %s\n", path, Mix_GetError());
+            return false;
+        }
+        SoundBankEntry entry;
+        entry.name = path;
+        entry.pcm.assign(chunk->abuf, chunk->abuf + chunk->alen);
+        Mix_FreeChunk(chunk);
+        total_bytes += entry.pcm.size();
+        entries.push_back(std::move(entry));
+    }
+
+    WriteSoundBank(static_cast<std::uint32_t>(frequency), format, static_cast<std::uint32_t>(channels), entries,
+                   out_blob);
+    SoundBankView check;
+    if (!BindSoundBank(out_blob->data(), out_blob->size(), &check) || check.SoundCount() != kSoundCount) {
+        std::fprintf(stderr, "compiled bank failed validation\n");
+        return false;
+    }
+    std::printf("%d sounds, %zu bytes of PCM\n", kSoundCount, total_bytes);
+    return true;
+}
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    if (argc != 2) {
+        std::fprintf(stderr, "usage: %s <out.bank>\n", argv[0]);
+        return 1;
+    }
+
+    // Nothing is played, so no audio hardware is needed.
+    SDL_setenv("SDL_AUDIODRIVER", "dummy", 0);
+    if (SDL_Init(SDL_INIT_AUDIO) != 0) {
+        std::fprintf(stderr, "SDL_Init failed: %s\n", SDL_GetError());
+        return 1;
+    }
+    Mix_Init(MIX_INIT_OGG);
+    if (Mix_OpenAudio(constants::kAudioFrequency, MIX_DEFAULT_FORMAT, constants::kAudioChannels,
+                      constants::kAudioChunkSamples) < 0) {
+        std::fprintf(stderr, "Mix_OpenAudio failed: %s\n", Mix_GetError());
+        SDL_Quit();
+        return 1;
+    }
+
+    std::vector<unsigned char> blob;
+    const bool built = BuildBank(&blob);
+    Mix_CloseAudio();
+    Mix_Quit();
+    SDL_Quit();
+    if (!built) {
+        return 1;
+    }
+    if (!WriteFile(argv[1], blob)) {
+        std::fprintf(stderr, "cannot write %s\n", argv[1]);
+        return 1;
+    }
+    std::printf("%s: %zu bytes\n", argv[1], blob.size());
+    return 0;
+}
@@ -0,0 +1,235 @@
+// Offline texture prescaler.
+//
+// Usage: texture_prescaler <out_dir> [--rgb565] [--scale=F]
+//
+// Resamples every ASSET_PRESCALED_TEXTURES entry from its design-size PNG to
+// the size it covers on screen (RenderContext scale for the 640x480 target
+// unless --scale is given) and writes <out_dir>/prescaled/<Name>.png plus a
+// Prescaled.txt index that Assets::LoadPrescaled reads at runtime. The index
+// keeps the design size, so layout code and draw calls are unchanged; only
+// the texture behind them shrinks.
+//
+// With --rgb565, images without any transparent pixel are dithered to 16-bit
+// colour and marked rgb565 in the index, so the game uploads them as RGB565
+// textures where the renderer supports it. Run from the repository root.
+
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_image.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "game/AssetIds.h"
+#include "game/Constants.h"
+
+namespace {
+constexpr TextureId kPrescaled[] = {
+#define PRESCALED_ID(name) TextureId::k##name,
+    ASSET_PRESCALED_TEXTURES(PRESCALED_ID)
+#undef PRESCALED_ID
+};
+
+// 4x4 ordered dither thresholds, in sixteenths.
+constexpr int kBayer4[4][4] = {{0, 8, 2, 10}, {12, 4, 14, 6}, {3, 11, 1, 9}, {15, 7, 13, 5}};
+
+std::string FileStem(const std::string& path) {
+    const size_t slash = path.find_last_of("/\\");
+    const size_t start = (slash == std::string::npos) ? 0 : slash + 1;
+    const size_t dot = path.find_last_of('.');
+    const size_t end = (dot == std::string::npos || dot < start) ? path.size() : dot;
+    return path.substr(start, end - start);
+}
+
+// Source texels overlapping one destination texel along an axis, with the
+// fraction of each that falls inside it.
+struct Span {
+    int first = 0;
+    std::vector<float> weights;
+};
+
+std::vector<Span> BuildSpans(int src_size, int dst_size) {
+    const double step = static_cast<double>(src_size) / static_cast<double>(dst_size);
+    std::vector<Span> spans(static_cast<size_t>(dst_size));
+    for (int i = 0; i < dst_size; ++i) {
+        const double begin = i * step;
+        const double end = std::min((i + 1) * step, static_cast<double>(src_size));
+        Span& span = spans[static_cast<size_t>(i)];
+        span.first = static_cast<int>(begin);
+        for (int s = span.first; s < end; ++s) {
+            const double covered = std::min(end, s + 1.0) - std::max(begin, static_cast<double>(s));
+            span.weights.push_back(static_cast<float>(covered / step));
+        }
+    }
+    return spans;
+}
+
+// Box-filters an RGBA32 surface down to `width` x `height`. Colour is averaged
+// weighted by alpha, so transparent texels do not darken the edges of the
+// land strips.
+SDL_Surface* Downscale(SDL_Surface* src, int width, int height) {
+    SDL_Surface* dst = SDL_CreateRGBSurfaceWithFormat(0, width, height, 32, SDL_PIXELFORMAT_RGBA32);
+    if (!dst) {
+        return nullptr;
+    }
+    const std::vector<Span> columns = BuildSpans(src->w, width);
+    const std::vector<Span> rows = BuildSpans(src->h, height);
+    for (int y = 0; y < height; ++y) {
+        const Span& row = rows[static_cast<size_t>(y)];
+        Uint8* out = static_cast<Uint8*>(dst->pixels) + y * dst->pitch;
+        for (int x = 0; x < width; ++x) {
+            const Span& column = columns[static_cast<size_t>(x)];
+            float sum[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+            for (size_t j = 0; j < row.weights.size(); ++j) {
+                const Uint8* in =
+                    static_cast<const Uint8*>(src->pixels) + (row.first + static_cast<int>(j)) * src->pitch;
+                for (size_t i = 0; i < column.weights.size(); ++i) {
+                    const Uint8* texel = in + (column.first + static_cast<int>(i)) * 4;
+                    const float weight = row.weights[j] * column.weights[i];
+                    const float alpha = texel[3] * weight;
+                    sum[0] += texel[0] * alpha;
+                    sum[1] += texel[1] * alpha;
+                    sum[2] += texel[2] * alpha;
+                    sum[3] += alpha;
+                }
+            }
+            Uint8* texel = out + x * 4;
+            for (int c = 0; c < 3; ++c) {
+                texel[c] = sum[3] > 0.0f ? static_cast<Uint8>(std::lround(std::min(sum[c] / sum[3], 255.0f))) : 0;
+            }
+            texel[3] = static_cast<Uint8>(std::lround(std::min(sum[3], 255.0f)));
+        }
+    }
+    return dst;
+}
+
+bool IsOpaque(SDL_Surface* surface) {
+    for (int y = 0; y < surface->h; ++y) {
+        const Uint8* row = static_cast<const Uint8*>(surface->pixels) + y * surface->pitch;
+        for (int x = 0; x < surface->w; ++x) {
+            if (row[x * 4 + 3] != 255) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+Uint8 Quantize(int value, int bits, int threshold) {
+    const int levels = (1 << bits) - 1;
+    // Offset by the dither threshold before truncating, then expand the level
+    // back to 8 bits exactly as SDL does, so converting the PNG to RGB565 at
+    // load time is lossless.
+    const int level = std::min(levels, (value * levels + threshold * 255 / 16) / 255);
+    return static_cast<Uint8>((level << (8 - bits)) | (level >> (2 * bits - 8)));
+}
+
+// Dithers an opaque RGBA32 surface to 5/6/5 levels and returns it as RGB24.
+SDL_Surface* DitherRgb565(SDL_Surface* src) {
+    SDL_Surface* dst = SDL_CreateRGBSurfaceWithFormat(0, src->w, src->h, 24, SDL_PIXELFORMAT_RGB24);
+    if (!dst) {
+        return nullptr;
+    }
+    for (int y = 0; y < src->h; ++y) {
+        const Uint8* in = static_cast<const Uint8*>(src->pixels) + y * src->pitch;
+        Uint8* out = static_cast<Uint8*>(dst->pixels) + y * dst->pitch;
+        for (int x = 0; x < src->w; ++x) {
+            const int threshold = kBayer4[y & 3][x & 3];
+            out[x * 3 + 0] = Quantize(in[x * 4 + 0], 5, threshold);
+            out[x * 3 + 1] = Quantize(in[x * 4 + 1], 6, threshold);
+            out[x * 3 + 2] = Quantize(in[x * 4 + 2], 5, threshold);
+        }
+    }
+    return dst;
+}
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        std::fprintf(stderr, "usage: %s <out_dir> [--rgb565] [--scale=F]\n", argv[0]);
+        return 1;
+    }
+    const std::string out_dir = argv[1];
+    bool rgb565 = false;
+    double scale = std::min(static_cast<double>(constants::kScreenWidth) / constants::kDesignWidth,
+                            static_cast<double>(constants::kScreenHeight) / constants::kDesignHeight);
+    for (int i = 2; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--rgb565") == 0) {
+            rgb565 = true;
+        } else if (std::strncmp(argv[i], "--scale=", 8) == 0 && std::atof(argv[i] + 8) > 0.0) {
+            scale = std::min(1.0, std::atof(argv[i] + 8));
+        } else {
+            std::fprintf(stderr, "invalid argument '%s'\n", argv[i]);
+            return 1;
+        }
+    }
+
+    if ((IMG_Init(IMG_INIT_PNG) & IMG_INIT_PNG) != IMG_INIT_PNG) {
+        std::fprintf(stderr, "IMG_Init failed: %s\n", SDL_GetError());
+        return 1;
+    }
+
+    const std::string index_path = out_dir + "/Prescaled.txt";
+    FILE* index = std::fopen(index_path.c_str(), "w");
+    if (!index) {
+        std::fprintf(stderr, "failed to open %s\n", index_path.c_str());
+        return 1;
+    }
+
+    size_t design_bytes = 0;
+    size_t scaled_bytes = 0;
+    for (TextureId id : kPrescaled) {
+        const char* path = TexturePath(id);
+        SDL_Surface* loaded = IMG_Load(path);
+        if (!loaded) {
+            std::fprintf(stderr, "failed to load %s: %s\n", path, SDL_GetError());
+            return 1;
+        }
+        SDL_Surface* design = SDL_ConvertSurfaceFormat(loaded, SDL_PIXELFORMAT_RGBA32, 0);
+        SDL_FreeSurface(loaded);
+        if (!design) {
+            std::fprintf(stderr, "failed to convert %s: %s\n", path, SDL_GetError());
+            return 1;
+        }
+        const int width = std::max(1, static_cast<int>(std::lround(design->w * scale)));
+        const int height = std::max(1, static_cast<int>(std::lround(design->h * scale)));
+        SDL_Surface* scaled = Downscale(design, width, height);
+        if (!scaled) {
+            std::fprintf(stderr, "failed to scale %s: %s\n", path, SDL_GetError());
+            return 1;
+        }
+        const bool as_rgb565 = rgb565 && IsOpaque(scaled);
+        if (as_rgb565) {
+            SDL_Surface* dithered = DitherRgb565(scaled);
+            SDL_FreeSurface(scaled);
+            scaled = dithered;
+            if (!scaled) {
+                std::fprintf(stderr, "failed to dither %s: %s\n", path, SDL_GetError());
+                return 1;
+            }
+        }
+
+        const std::string name = FileStem(path);
+        const std::string file = "prescaled/" + name + ".png";
+        if (IMG_SavePNG(scaled, (out_dir + "/" + file).c_str()) != 0) {
+            std::fprintf(stderr, "failed to write %s: %s\n", file.c_str(), SDL_GetError());
+            return 1;
+        }
+        std::fprintf(index, "texture %s %s %d %d %s\n", name.c_str(), file.c_str(), design->w, design->h,
+                     as_rgb565 ? "rgb565" : "rgba8888");
+        design_bytes += static_cast<size_t>(design->w) * static_cast<size_t>(design->h) * 4;
+        scaled_bytes += static_cast<size_t>(width) * static_cast<size_t>(height) * (as_rgb565 ? 2 : 4);
+        SDL_FreeSurface(design);
+        SDL_FreeSurface(scaled);
+    }
+    std::fclose(index);
+
+    std::printf("prescaled %zu textures by %.3f: %zu KB -> %zu KB of texture memory\n",
+                sizeof(kPrescaled) / sizeof(kPrescaled[0]), scale, design_bytes / 1024, scaled_bytes / 1024);
+    IMG_Quit();
+    return 0;
+}